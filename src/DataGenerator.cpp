@@ -26,9 +26,16 @@ namespace identity{
 /**
  * This constructor should be used for all vs. all
  */
-DataGenerator::DataGenerator(std::string fileName, int blockSize) {
-	FastaReader reader(fileName, blockSize);
-	block = reader.read();
+DataGenerator::DataGenerator(std::string fileName, int blockSize) :
+		DataGenerator(FastaReader(fileName, blockSize).read()) {
+}
+
+/**
+ * This constructor should be used for all vs. all on sequences
+ * that are already in memory. The generator owns the block.
+ */
+DataGenerator::DataGenerator(Block *blockIn) {
+	block = blockIn;
 
 	calculateK();
 	calculateHistSize();
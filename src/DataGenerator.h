@@ -56,6 +56,7 @@ protected:
 public:
 	DataGenerator(std::string, int blockSize = Parameters::getBlockSize());
 	DataGenerator(std::string, std::string, double);
+	DataGenerator(Block *);
 	virtual ~DataGenerator();
 
 	// Free memory used by the two tables before the object is destroyed
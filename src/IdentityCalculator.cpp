@@ -173,13 +173,26 @@ IdentityCalculator<V>::~IdentityCalculator()
 template <class V>
 double IdentityCalculator<V>::score(std::string *seq1, std::string *seq2)
 {
-	V *kHist1 = kTable->build(seq1);
-	uint64_t *monoHist1 = monoTable->build(seq1);
-	V *kHist2 = kTable->build(seq2);
-	uint64_t *monoHist2 = monoTable->build(seq2);
+	// Packed once; both histograms of a sequence are read from it
+	utility::PackedSequence packed1(*seq1);
+	utility::PackedSequence packed2(*seq2);
+	return score(&packed1, 0, packed1.size(), &packed2, 0, packed2.size());
+}
+
+/**
+ * One region versus another, read from packed sequences without copying them
+ */
+template <class V>
+double IdentityCalculator<V>::score(const utility::PackedSequence *seq1, int start1, int end1,
+									const utility::PackedSequence *seq2, int start2, int end2)
+{
+	V *kHist1 = kTable->build(seq1, start1, end1);
+	uint64_t *monoHist1 = monoTable->build(seq1, start1, end1);
+	V *kHist2 = kTable->build(seq2, start2, end2);
+	uint64_t *monoHist2 = monoTable->build(seq2, start2, end2);
 
-	int len1 = seq1->size();
-	int len2 = seq2->size();
+	int len1 = end1 - start1;
+	int len2 = end2 - start2;
 
 	double r = score(kHist1, kHist2, monoHist1, monoHist2, calcRatio(len1, len2), len1, len2);
 
@@ -316,8 +329,9 @@ std::tuple<V **, uint64_t **, std::string **, int *> IdentityCalculator<V>::unpa
 		auto p = block->at(i);
 		infoList[i] = p.first;
 		std::string *seq = p.second;
-		kHistList[i] = kTable->build(seq);
-		monoHistList[i] = monoTable->build(seq);
+		utility::PackedSequence packed(*seq);
+		kHistList[i] = kTable->build(&packed, 0, packed.size());
+		monoHistList[i] = monoTable->build(&packed, 0, packed.size());
 		// A check
 		if (Util::isAllZeros(kHistList[i], kHistSize) || Util::isAllZeros(monoHistList[i], monoHistSize))
 		{
@@ -154,6 +154,12 @@ public:
 	 */
 	double score(std::string *seq1, std::string *seq2);
 
+	/**
+	 * One region versus another; regions are [start, end) of packed sequences
+	 */
+	double score(const utility::PackedSequence *seq1, int start1, int end1,
+				 const utility::PackedSequence *seq2, int start2, int end2);
+
 	/**
 	 * Score one versus many
 	 */
@@ -8,6 +8,9 @@
 
 namespace identity{
 
+template<class I, class V>
+const uint8_t KmerHistogram<I, V>::packedDigitList[4] = { 2, 0, 3, 1 }; // A, C, G, T
+
 template<class I, class V>
 KmerHistogram<I, V>::KmerHistogram(int keyLength) :
 		k(keyLength) {
@@ -75,7 +78,8 @@ I KmerHistogram<I, V>::hash(const string *sequence, int keyStart) {
 }
 
 /**
- *
+ * The hashes of the k-mers starting at start through end, rolled over the
+ * characters. A caller with a packed sequence should use the overload below.
  */
 template<class I, class V>
 void KmerHistogram<I, V>::hash(const string *sequence, int start, int end,
@@ -92,6 +96,17 @@ void KmerHistogram<I, V>::hash(const string *sequence, int start, int end,
 	}
 }
 
+/**
+ * The same hashes from a packed sequence, which needs no lookup per character.
+ */
+template<class I, class V>
+void KmerHistogram<I, V>::hash(const utility::PackedSequence *sequence,
+		int start, int end, vector<I> *hashList) {
+	sequence->forEachKmer(k, start, end, [hashList](int i, uint64_t h) {
+		hashList->push_back(static_cast<I>(h));
+	}, packedDigitList);
+}
+
 template<class I, class V>
 vector<pair<int, int> > KmerHistogram<I, V>::makeSegments(
 		const string *sequence) {
@@ -128,6 +143,25 @@ vector<pair<int, int> > KmerHistogram<I, V>::makeSegments(
 	return segmentList;
 }
 
+/**
+ * The segments of [start, end) of a packed sequence
+ */
+template<class I, class V>
+vector<pair<int, int> > KmerHistogram<I, V>::makeSegments(
+		const utility::PackedSequence *sequence, int start, int end) {
+	vector < pair<int, int> > segmentList = sequence->makeSegments(start, end);
+
+	// Post condition
+	if (segmentList.empty()) {
+		cerr << "KmerHistogram: At least one valid segment is required.";
+		cerr << endl;
+		cerr << "Sequence: " << sequence->toString(start, end) << std::endl;
+		throw std::exception();
+	}
+
+	return segmentList;
+}
+
 /**
  * Build a k-mer histogram from DNA sequence efficiently.
  * sequence: Count k-mers in this sequence.
@@ -139,10 +173,6 @@ V* KmerHistogram<I, V>::build(const string *sequence) {
 
 	vector < pair<int, int> > segmentList = makeSegments(sequence);
 
-	// Test code
-	//std::cout << "Number of segments is: " << segmentList.size() << std::endl;
-	// End of test code
-
 	V * valueList = initialize(0);
 
 	// Increment k-mer's in each valid segment
@@ -159,7 +189,42 @@ V* KmerHistogram<I, V>::build(const string *sequence) {
 		}
 	}
 
-	// Check overflow
+	checkOverflow(valueList);
+	return valueList;
+}
+
+/**
+ * Build a k-mer histogram of [start, end) of a packed sequence.
+ * The k-mers are hashed a block at a time; no hash list is kept.
+ * Memory: The client is responsible for destroying the histogram.
+ */
+template<class I, class V>
+V* KmerHistogram<I, V>::build(const utility::PackedSequence *sequence,
+		int start, int end) {
+
+	vector < pair<int, int> > segmentList = makeSegments(sequence, start, end);
+
+	V * valueList = initialize(0);
+
+	// Increment k-mer's in each valid segment
+	for (auto segment : segmentList) {
+		if (segment.first <= segment.second - k + 1) {
+			sequence->forEachKmer(k, segment.first, segment.second - k + 1,
+					[valueList](int i, uint64_t h) {
+						valueList[h]++;
+					}, packedDigitList);
+		}
+	}
+
+	checkOverflow(valueList);
+	return valueList;
+}
+
+/**
+ * A negative value is a likely indication of overflow.
+ */
+template<class I, class V>
+void KmerHistogram<I, V>::checkOverflow(V *valueList) {
 	for (I y = 0; y < maxTableSize; y++) {
 		if (valueList[y] < 0) {
 			cerr << "A negative value is a likely indication of overflow.";
@@ -170,8 +235,6 @@ V* KmerHistogram<I, V>::build(const string *sequence) {
 			throw std::exception();
 		}
 	}
-
-	return valueList;
 }
 
 template<class I, class V>
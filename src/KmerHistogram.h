@@ -18,6 +18,7 @@
 #include <tuple>
 
 #include "Parameters.h"
+#include "utility/PackedSequence.h"
 
 using namespace std;
 
@@ -37,6 +38,10 @@ private:
 	I bases[maxKeyLength];
 	I mMinusOne[4];
 	int digitList['T' + 1];
+	// The digits above of the codes of a PackedSequence
+	static const uint8_t packedDigitList[4];
+
+	void checkOverflow(V *);
 
 public:
 	/* Methods */
@@ -46,8 +51,10 @@ public:
 	I hash(const string*);
 	I hash(const string*, int);
 	void hash(const string*, int, int, vector<I>*);
+	void hash(const utility::PackedSequence*, int, int, vector<I>*);
 
 	V* build(const string *sequence);
+	V* build(const utility::PackedSequence *sequence, int start, int end);
 	V* initialize(int initValue);
 
 
@@ -57,6 +64,7 @@ public:
 	void printPythonFormat(V*);
 
 	vector < pair<int, int> > makeSegments(const string *);
+	vector < pair<int, int> > makeSegments(const utility::PackedSequence *, int, int);
 
 	int getK();
 	I getMaxTableSize();
@@ -58,6 +58,9 @@ const static string FRM_PRM = string("-frm"); // Format of the ouput
 // Cores 
 const static string COR_PRM = string("-cor");
 
+// Smoothing of the scores when detecting candidates
+const static string SMO_PRM = string("-smo");
+
 void drive(map<string, string> * const param) {
 	// Delete old output files
 	if (param->count(MSK_PRM) > 0) {
@@ -107,6 +110,7 @@ void drive(map<string, string> * const param) {
 		double s = atoi(param->at(GAU_PRM).c_str());
 		double t = atoi(param->at(THR_PRM).c_str());
 		int minObs = atoi(param->at(MIN_PRM).c_str());
+		bool isFastSmoothing = atoi(param->at(SMO_PRM).c_str()) == 1;
 
 		// Adjust the threshold when it is one because of the log base.
 		if (((int) t) == 1) {
@@ -118,9 +122,10 @@ void drive(map<string, string> * const param) {
 		Trainer * trainer;
 		if (param->count(CND_PRM) > 0) {
 			trainer = new Trainer(genomeDir, order, k, s, t, param->at(CND_PRM),
-					minObs);
+					minObs, nullptr, isFastSmoothing);
 		} else {
-			trainer = new Trainer(genomeDir, order, k, s, t, minObs);
+			trainer = new Trainer(genomeDir, order, k, s, t, minObs, nullptr,
+					isFastSmoothing);
 		}
 
 		if (param->count(TBL_PRM)) {
@@ -358,6 +363,8 @@ int main(int argc, char * argv[]) {
 	message.append(
 			"\t\tThe output format are zero based and the end is exclusive.\n");
 	message.append("\t-hmo file where the HMM is saved, optional.\n");
+	message.append(
+			"\t-smo the smoothing of the scores when detecting candidates: 0 (Gaussian mask) or 1 (fast, box filters). The default is 0.\n");
 	message.append("\t-cor integer of the number of threads, optional.\n");
 	message.append("\t\tThe more threads, the higher the memory requirement.\n");
 	message.append("\t\tThe defaul is the number of cores - 1, or 1 if single core is found.\n\n");
@@ -392,6 +399,7 @@ int main(int argc, char * argv[]) {
 	validParam->insert(map<string, string>::value_type(MIN_PRM, "DUMMY"));
 	validParam->insert(map<string, string>::value_type(FRM_PRM, "DUMMY"));
 	validParam->insert(map<string, string>::value_type(COR_PRM, "DUMMY"));
+	validParam->insert(map<string, string>::value_type(SMO_PRM, "DUMMY"));
 
 	// Make a table of the user provided arguments
 	map<string, string> *param = new map<string, string>();
@@ -540,6 +548,19 @@ int main(int argc, char * argv[]) {
 				}
 			}
 
+			if (param->count(SMO_PRM) == 0) {
+				param->insert(
+						map<string, string>::value_type(SMO_PRM, string("0")));
+			} else {
+				int smo = atoi(param->at(SMO_PRM).c_str());
+				if (smo != 0 && smo != 1) {
+					cerr << "The smoothing must be 0 or 1. The value received is ";
+					cerr << param->at(SMO_PRM) << "." << endl;
+					cerr << message << endl;
+					return 1;
+				}
+			}
+
 			if (param->count(GAU_PRM) == 0) {
 				cout << "Calculating GC content ..." << endl;
 
@@ -25,7 +25,7 @@
 namespace identity{
 
 std::ostream& operator<<(std::ostream &out, Feature &f) {
-	out << std::setprecision(16);
+	out << std::setprecision(std::numeric_limits<double>::max_digits10);
 	out << f.getNumOfComp() << "\t";
 	if (f.getNumOfComp() == 0) {
 		out << f.getFunIndex() << "\t";
@@ -58,7 +58,7 @@ Serializer::Serializer(std::vector<Feature*> *featList, double *compList, int k,
 	this->maxLength = maxLength;
 
 	std::ofstream out(file);
-	out << std::setprecision(16);
+	out << std::setprecision(std::numeric_limits<double>::max_digits10);
 	out << k << std::endl;
 	out << histSize << std::endl;
 	out << absError << std::endl;
@@ -28,6 +28,7 @@
 #include <fstream>
 #include <iomanip>
 #include <map>
+#include <limits>
 
 #include "Feature.h"
 #include "FeatureSquared.h"
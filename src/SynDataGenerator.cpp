@@ -43,6 +43,16 @@ SynDataGenerator::SynDataGenerator(string dbName, string qryName, double t,
 	generateData();
 }
 
+SynDataGenerator::SynDataGenerator(Block *block, double t, int threadNumIn,
+		std::vector<int> funIndexList) :
+		DataGenerator(block) {
+	threshold = t;
+	this->funIndexList = funIndexList;
+	threadNum = threadNumIn;
+	fillCompositionList();
+	generateData();
+}
+
 SynDataGenerator::~SynDataGenerator() {
 	if (fTable != nullptr) {
 		delete fTable;
@@ -47,6 +47,8 @@ public:
 			std::vector<int>());
 	SynDataGenerator(std::string, std::string, double, int,
 			std::vector<int> funIndexList = std::vector<int>());
+	SynDataGenerator(Block *, double, int, std::vector<int> funIndexList =
+			std::vector<int>());
 	virtual ~SynDataGenerator();
 	virtual void generateData();
 	virtual void clearData();
@@ -1,7 +1,7 @@
 #include "CaseMatcher.h"
 
 // [OK]
-CaseMatcher::CaseMatcher(IdentityCalculator<int32_t> &_ic, IdentityCalculator<int32_t> &_icRecent, Red &_red, const std::string *_seq) : ic(_ic), icRecent(_icRecent), red(_red), seq(_seq)
+CaseMatcher::CaseMatcher(IdentityCalculator<int32_t> &_ic, IdentityCalculator<int32_t> &_icRecent, const RedScoreTrack &_redTrack, const std::string *_seq) : ic(_ic), icRecent(_icRecent), redTrack(_redTrack), seq(_seq)
 {
 }
 
@@ -84,22 +84,6 @@ bool CaseMatcher::checkLength(Element *e) {
     return e->getSize() >= LtrParameters::MIN_LTR;
 }
 
-// [OK]
-int CaseMatcher::adjustSize(int s, int e) {
-    int end = e + red.getK() - 1;
-    if(end > seq->size()){
-        end = seq->size();
-    }
-    return end - s;
-}
-
-// [OK]
-std::vector<int> CaseMatcher::scoreSeq(int s, int e) {
-    int size = adjustSize(s, e);
-    std::string subSeq = seq->substr(s, size);
-    return red.score(subSeq);
-}
-
 // [OK]
 bool CaseMatcher::isAfter(Element *e1, Element *e2) {
     return e1->getStart() >= e2->getEnd();
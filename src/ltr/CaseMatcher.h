@@ -27,7 +27,7 @@
 #include "DirectedGraph.h"
 #include "Element.h"
 #include "RT.h"
-#include "../red/Red.h"
+#include "../red/RedScoreTrack.h"
 #include "../IdentityCalculator.h"
 #include "LtrParameters.h"
 #include "LtrUtility.h"
@@ -49,7 +49,7 @@ public:
     /**
      * Constructor
      */
-    CaseMatcher(IdentityCalculator<int32_t> &_ic, IdentityCalculator<int32_t> &_icRecent, Red &_red, const std::string *_seq);
+    CaseMatcher(IdentityCalculator<int32_t> &_ic, IdentityCalculator<int32_t> &_icRecent, const RedScoreTrack &_redTrack, const std::string *_seq);
 
     /**
      * Methods
@@ -80,7 +80,7 @@ protected:
     std::vector<RT *> rtVec;
     IdentityCalculator<int32_t> &ic;
     IdentityCalculator<int32_t> &icRecent;
-    Red &red;
+    const RedScoreTrack &redTrack;
     const std::string *seq;
 
     // Rank is used to determine which analysis case to use
@@ -102,9 +102,6 @@ protected:
 
     bool checkLength(Element *e);
 
-    // This method calculates the length of a complete RT elmeent and adjusts the end by k - 1
-    int adjustSize(int s, int e);
-
     // Is e1 after e2 location wise? i.e., e1 is to the right of e2 AND there is a gap between.
     bool isAfter(Element *e1, Element *e2);
 
@@ -124,8 +121,6 @@ protected:
 
     std::tuple<Element*, Element*> assignLtrs(Element *built, Element *left, Element *right);
 
-    std::vector<int> scoreSeq(int s, int e);
-
     std::string substrInterior(Element * e1, Element *e2, std::string *seq);
 
     bool areSeqSame(std::string &seq1, std::string &seq2);
@@ -25,7 +25,7 @@
 
 #include "CaseRecent.h"
 
-CaseRecent::CaseRecent(IdentityCalculator<int32_t> &_ic, IdentityCalculator<int32_t> &_icRecent, Red &_red, const std::string *_seq) : CaseMatcher(_ic, _icRecent, _red, _seq){
+CaseRecent::CaseRecent(IdentityCalculator<int32_t> &_ic, IdentityCalculator<int32_t> &_icRecent, const RedScoreTrack &_redTrack, const std::string *_seq) : CaseMatcher(_ic, _icRecent, _redTrack, _seq){
     name = "RecentlyNested";
     rank = 400;
 }
@@ -45,7 +45,7 @@ void CaseRecent::apply(DirectedGraph<Element> &graph, std::vector<Element *> &fo
      *  
     */
 
-    CaseSingle cs{ic, icRecent, red, seq};
+    CaseSingle cs{ic, icRecent, redTrack, seq};
     // std::vector<RT *> rtVec = cs.apply(graph, forwardVec, backwardVec, graphIndex);
 
 
@@ -193,29 +193,14 @@ bool CaseRecent::checkOuterRt(Element *leftLtr, Element *nestedLeftLtr, Element
     assert (isAfter(rightLtr, nestedLeftLtr));
 
 
-    CaseSingle cs{ic, icRecent, red, seq};
+    CaseSingle cs{ic, icRecent, redTrack, seq};
     
     bool r = false;
     
     bool isGap = leftLtr->calcGap(*nestedLeftLtr) > 0 || nestedRightLtr->calcGap(*rightLtr) > 0;
 
     if (isGap) {
-        auto s1 = 0;
-        auto s2 = s1 + leftLtr->getSize();
-        auto s3 = s2 + nestedLeftLtr->getStart() - leftLtr->getEnd();
-        auto s4 = s3 + nestedRightLtr->getEnd() - nestedLeftLtr->getStart();
-        auto s5 = s4 + rightLtr->getStart() - nestedRightLtr->getEnd();
-
-        std::vector<int> rtScoreVec = scoreSeq(leftLtr->getStart(), rightLtr->getEnd());
-
-        std::vector<int> leftLtrScoreVec{rtScoreVec.begin() + s1, rtScoreVec.begin() + s2};
-
-        std::vector<int> interiorScoreVec{rtScoreVec.begin() + s2, rtScoreVec.begin() + s3};
-        interiorScoreVec.insert(interiorScoreVec.end(), rtScoreVec.begin() + s4, rtScoreVec.begin() + s5);
-        
-        std::vector<int> rightLtrScoreVec{rtScoreVec.begin() + s5, rtScoreVec.end()};
-
-        r = cs.checkSingle(leftLtrScoreVec, interiorScoreVec, rightLtrScoreVec);
+        r = cs.checkSingle({{leftLtr->getEnd(), nestedLeftLtr->getStart()}, {nestedRightLtr->getEnd(), rightLtr->getStart()}});
     }
 
     return r;
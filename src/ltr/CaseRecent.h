@@ -29,14 +29,14 @@
 #include "CaseSolo.h"
 #include "LtrParameters.h"
 #include "../IdentityCalculator.h"
-#include "../red/Red.h"
+#include "../red/RedScoreTrack.h"
 
 
 #include <iostream>
 
 class CaseRecent : public CaseMatcher {
     public:
-        CaseRecent(IdentityCalculator<int32_t> &_ic, IdentityCalculator<int32_t> &_icRecent, Red &_red, const std::string *_seq);
+        CaseRecent(IdentityCalculator<int32_t> &_ic, IdentityCalculator<int32_t> &_icRecent, const RedScoreTrack &_redTrack, const std::string *_seq);
 
         void apply(DirectedGraph<Element>& graph, std::vector<Element*>& forwardVec, std::vector<Element*>& backwardVec, int graphIndex);
     
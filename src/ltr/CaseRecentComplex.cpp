@@ -25,7 +25,7 @@
 
 #include "CaseRecentComplex.h"
 
-CaseRecentComplex::CaseRecentComplex(IdentityCalculator<int32_t> &_ic, IdentityCalculator<int32_t> &_icRecent, Red &_red, const std::string *_seq) : CaseMatcher(_ic, _icRecent, _red, _seq){
+CaseRecentComplex::CaseRecentComplex(IdentityCalculator<int32_t> &_ic, IdentityCalculator<int32_t> &_icRecent, const RedScoreTrack &_redTrack, const std::string *_seq) : CaseMatcher(_ic, _icRecent, _redTrack, _seq){
     name = "RecentComplex";
     rank = -1;
 }
@@ -47,7 +47,7 @@ void CaseRecentComplex::apply(DirectedGraph<Element> &graph, std::vector<Element
      * and should be noted as such. Another case may fire off in this region, but for all intents and purposes, it is just the best guess.
      */
 
-    CaseSingle cs{ic, icRecent, red, seq};
+    CaseSingle cs{ic, icRecent, redTrack, seq};
 
 
     // Ensures this is more complicated than a single case, at the very least.
@@ -27,7 +27,7 @@
 #include "CaseMatcher.h"
 #include "RTComplex.h"
 #include "DirectedGraph.h"
-#include "../red/Red.h"
+#include "../red/RedScoreTrack.h"
 #include "../IdentityCalculator.h"
 #include "CaseSingle.h"
 
@@ -39,7 +39,7 @@
 
 class CaseRecentComplex : public CaseMatcher {
     public:
-        CaseRecentComplex(IdentityCalculator<int32_t> &_ic, IdentityCalculator<int32_t> &_icRecent, Red &_red, const std::string *_seq);
+        CaseRecentComplex(IdentityCalculator<int32_t> &_ic, IdentityCalculator<int32_t> &_icRecent, const RedScoreTrack &_redTrack, const std::string *_seq);
 
         void apply(DirectedGraph<Element> &graph, std::vector<Element *> &forwardVec, std::vector<Element *> &backwardVec, int graphIndex);
 };
@@ -3,7 +3,7 @@
 
 #include "CaseSingle.h"
 
-CaseSingle::CaseSingle(IdentityCalculator<int32_t> &_ic, IdentityCalculator<int32_t> &_icRecent, Red &_red, const std::string *_seq) : CaseMatcher(_ic, _icRecent, _red, _seq)
+CaseSingle::CaseSingle(IdentityCalculator<int32_t> &_ic, IdentityCalculator<int32_t> &_icRecent, const RedScoreTrack &_redTrack, const std::string *_seq) : CaseMatcher(_ic, _icRecent, _redTrack, _seq)
 {
     name = "Single";
     rank = 100;
@@ -55,23 +55,13 @@ void CaseSingle::apply(DirectedGraph<Element> &graph, std::vector<Element *> &fo
 }
 
 bool CaseSingle::checkSingle(Element* leftLtr, Element* rightLtr) {
-    // Sequences for the LTRs and the interior
+    // Red scores of the interior
 
     bool r = false;
     bool isGap = leftLtr->calcGap(*rightLtr) > 0;
 
     if (isGap) {
-        std::vector<int> rtScoreVec = scoreSeq(leftLtr->getStart(), rightLtr->getEnd());
-
-        auto s1 = 0;
-        auto s2 = s1 + leftLtr->getSize();
-        auto s3 = s2 + rightLtr->getStart() - leftLtr->getEnd();
-
-
-        std::vector<int> leftLtrScoreVec{rtScoreVec.begin() + s1, rtScoreVec.begin() + s2};
-        std::vector<int> interiorScoreVec{rtScoreVec.begin() + s2, rtScoreVec.begin() + s3};
-        std::vector<int> rightLtrScoreVec{rtScoreVec.begin() + s3, rtScoreVec.end()};
-        r = checkSingle(leftLtrScoreVec, interiorScoreVec, rightLtrScoreVec);
+        r = checkSingle({{leftLtr->getEnd(), rightLtr->getStart()}});
     }
 
 
@@ -81,20 +71,8 @@ bool CaseSingle::checkSingle(Element* leftLtr, Element* rightLtr) {
     return r;
 }
 
-bool CaseSingle::checkSingle(std::vector<int> &leftLtrScoreVec, std::vector<int> &interiorScoreVec, std::vector<int> &rightLtrScoreVec) {
-
-    bool r = false;
-
-    // Median calculation does not involve the zero RED scores
-    double leftLtrScoreMedian = LtrUtility::calcMedian(leftLtrScoreVec);
-    double interiorScoreMedian = LtrUtility::calcMedian(interiorScoreVec);
-    double rightLtrScoreMedian = LtrUtility::calcMedian(rightLtrScoreVec); 
-
-    double interiorPerc = LtrUtility::calcPercent(interiorScoreVec);
-
-    r = interiorPerc >= LtrParameters::MIN_PERC;
-
-    return r;
+bool CaseSingle::checkSingle(const std::vector<std::pair<int, int>> &interiorVec) {
+    return redTrack.calcPercent(interiorVec) >= LtrParameters::MIN_PERC;
 }
 
 void CaseSingle::filterSequential() {
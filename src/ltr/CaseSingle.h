@@ -25,7 +25,7 @@
 
 #include "CaseMatcher.h"
 #include "RTComplete.h"
-#include "../red/Red.h"
+#include "../red/RedScoreTrack.h"
 #include "../IdentityCalculator.h"
 #include "LtrUtility.h"
 #include "unordered_map"
@@ -36,12 +36,13 @@
 class CaseSingle: public CaseMatcher
 {
     public:
-        CaseSingle(IdentityCalculator<int32_t> &_ic, IdentityCalculator<int32_t> &_icRecent, Red &_red, const std::string *_seq);
+        CaseSingle(IdentityCalculator<int32_t> &_ic, IdentityCalculator<int32_t> &_icRecent, const RedScoreTrack &_redTrack, const std::string *_seq);
 
         void apply(DirectedGraph<Element>& graph, std::vector<Element*>& forwardVec, std::vector<Element*>& backwardVec, int graphIndex);
 
         bool checkSingle(Element* left, Element* right);
-        bool checkSingle(std::vector<int> &leftLtrScoreVec, std::vector<int> &interiorScoreVec, std::vector<int> &rightLtrScoreVec);
+        // Is the interior, given as [start, end) intervals of the sequence, repetitive enough?
+        bool checkSingle(const std::vector<std::pair<int, int>> &interiorVec);
         void filterSequential();
 
 
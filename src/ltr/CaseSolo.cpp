@@ -24,7 +24,7 @@
 
 #include "CaseSolo.h"
 
-CaseSolo::CaseSolo(IdentityCalculator<int32_t> &_ic, IdentityCalculator<int32_t> &_icRecent, Red &_red, const std::string *_seq) : CaseMatcher(_ic, _icRecent, _red, _seq)
+CaseSolo::CaseSolo(IdentityCalculator<int32_t> &_ic, IdentityCalculator<int32_t> &_icRecent, const RedScoreTrack &_redTrack, const std::string *_seq) : CaseMatcher(_ic, _icRecent, _redTrack, _seq)
 {
     name = "Solo";
     rank = 150;
@@ -55,7 +55,7 @@ void CaseSolo::apply(DirectedGraph<Element> &graph, std::vector<Element *> &forw
      * the solo LTR. If both the interiors together have a high red score, then the solo LTR is between.
      */
 
-    CaseSingle cs{ic, icRecent, red, seq};
+    CaseSingle cs{ic, icRecent, redTrack, seq};
 
     try {
     // minimum required for this structure
@@ -132,7 +132,7 @@ void CaseSolo::apply(DirectedGraph<Element> &graph, std::vector<Element *> &forw
 bool CaseSolo::checkNestedSolo(Element *leftLtr, std::vector<Element *> nestVec, Element *rightLtr)
 {
     bool r = false;
-    CaseSingle cs{ic, icRecent, red, seq};
+    CaseSingle cs{ic, icRecent, redTrack, seq};
     Element *last = leftLtr;
     bool properOrder = true;
     for (auto nest : nestVec)
@@ -147,34 +147,25 @@ bool CaseSolo::checkNestedSolo(Element *leftLtr, std::vector<Element *> nestVec,
     if (properOrder)
     {
 
-        std::vector<int> rtScoreVec = scoreSeq(leftLtr->getStart(), rightLtr->getEnd());
-
-        auto s1 = 0;
-        auto s2 = s1 + leftLtr->getSize();
-        auto s3 = s2 + rightLtr->getStart() - leftLtr->getEnd();
-        int start = leftLtr->getStart();
-
-        std::vector<std::vector<int>> ltrScoreVec = {std::vector<int>{rtScoreVec.begin() + s1, rtScoreVec.begin() + s2}};
-        std::vector<int> interiorScoreVec;
-
+        std::vector<std::pair<int, int>> interiorVec;
         last = leftLtr;
         for (auto nest : nestVec)
         {
-            ltrScoreVec.push_back(std::vector<int>{rtScoreVec.begin() + nest->getStart() - start,
-                                                   rtScoreVec.begin() + nest->getEnd() - start});
-            interiorScoreVec.insert(interiorScoreVec.end(), rtScoreVec.begin() + last->getEnd() - start,
-                                    rtScoreVec.begin() + nest->getStart() - start);
+            if (nest->getStart() > last->getEnd())
+            {
+                interiorVec.push_back({last->getEnd(), nest->getStart()});
+            }
             last = nest;
         }
+        if (rightLtr->getStart() > last->getEnd())
+        {
+            interiorVec.push_back({last->getEnd(), rightLtr->getStart()});
+        }
 
-        ltrScoreVec.push_back(std::vector<int>{rtScoreVec.begin() + s3, rtScoreVec.end()});
-        interiorScoreVec.insert(interiorScoreVec.end(), rtScoreVec.begin() + last->getEnd() - start,
-                                rtScoreVec.begin() + rightLtr->getStart() - start);
-
-        bool isGap = interiorScoreVec.size() > 0;
+        bool isGap = interiorVec.size() > 0;
         if (isGap)
         {
-            double interiorPerc = LtrUtility::calcPercent(interiorScoreVec);
+            double interiorPerc = redTrack.calcPercent(interiorVec);
             r = interiorPerc >= LtrParameters::MIN_PERC;
         }
     }
@@ -185,30 +176,14 @@ bool CaseSolo::checkNestedSolo(Element *leftLtr, std::vector<Element *> nestVec,
 bool CaseSolo::checkNestedSolo(Element *leftLtr, Element *nestedLtr, Element *rightLtr)
 {
     bool r = false;
-    CaseSingle cs{ic, icRecent, red, seq};
+    CaseSingle cs{ic, icRecent, redTrack, seq};
 
     bool isGap = leftLtr->calcGap(*nestedLtr) > 0 || nestedLtr->calcGap(*rightLtr) > 0;
 
     if (isGap)
     {
 
-        std::vector<int> rtScoreVec = scoreSeq(leftLtr->getStart(), rightLtr->getEnd());
-
-        auto s1 = 0;
-        auto s2 = s1 + leftLtr->getSize();
-        auto s3 = s2 + rightLtr->getStart() - leftLtr->getEnd();
-        auto nStart = s2 + nestedLtr->getStart() - leftLtr->getEnd();
-        auto nEnd = nStart + nestedLtr->getSize();
-
-        std::vector<int> leftLtrScoreVec{rtScoreVec.begin() + s1, rtScoreVec.begin() + s2};
-        std::vector<int> interiorScoreVec{rtScoreVec.begin() + s2, rtScoreVec.begin() + nStart};
-        interiorScoreVec.insert(interiorScoreVec.end(), rtScoreVec.begin() + nEnd, rtScoreVec.begin() + s3);
-        std::vector<int> rightLtrScoreVec{rtScoreVec.begin() + s3, rtScoreVec.end()};
-        std::vector<int> nestedLtrScoreVec{rtScoreVec.begin() + nStart, rtScoreVec.begin() + nEnd};
-
-        double interiorMedian = LtrUtility::calcMedian(interiorScoreVec);
-        double nestedLtrMedian = LtrUtility::calcMedian(nestedLtrScoreVec);
-        r = cs.checkSingle(leftLtrScoreVec, interiorScoreVec, rightLtrScoreVec);
+        r = cs.checkSingle({{leftLtr->getEnd(), nestedLtr->getStart()}, {nestedLtr->getEnd(), rightLtr->getStart()}});
     }
 
     return r;
@@ -27,14 +27,14 @@
 #include "CaseSingle.h"
 #include "RTComplete.h"
 #include "RTSolo.h"
-#include "../red/Red.h"
+#include "../red/RedScoreTrack.h"
 #include "../IdentityCalculator.h"
 
 
 class CaseSolo : public CaseMatcher
 {
     public:
-        CaseSolo(IdentityCalculator<int32_t> &_ic, IdentityCalculator<int32_t> &_icRecent, Red &_red, const std::string *_seq);
+        CaseSolo(IdentityCalculator<int32_t> &_ic, IdentityCalculator<int32_t> &_icRecent, const RedScoreTrack &_redTrack, const std::string *_seq);
 
         void apply(DirectedGraph<Element>& graph, std::vector<Element*>& forwardVec, std::vector<Element*>& backwardVec, int graphIndex);
 
@@ -0,0 +1,346 @@
+/*
+ * LtrDetector v2.0 annotates LTR retro-transposons in a genome.
+ *
+ * Checkpoint
+ *
+ *  Created on: Oct 17, 2026
+ * Reviewer:
+ *   Purpose: Records which per-chromosome stages of look4ltrs are finished, so --resume can skip them.
+ *
+ * Academic use: Affero General Public License version 1.
+ *
+ * Any restrictions to use for-profit or non-academics: Alternative commercial license is needed.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Please contact Dr. Hani Z. Girgis (hzgirgis@buffalo.edu) if you need more information.
+ *
+ * Copyright (C) 2022 by the authors.
+ */
+
+#include "Checkpoint.h"
+
+#include <unordered_map>
+#include <memory>
+
+namespace {
+
+template<class T>
+void writeValue(std::ostream &out, const T &value) {
+    out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template<class T>
+T readValue(std::istream &in) {
+    T value;
+    in.read(reinterpret_cast<char *>(&value), sizeof(T));
+    if (!in) {
+        throw CorruptCheckpointException("The checkpoint is truncated.");
+    }
+    return value;
+}
+
+// A count of items that follow; each item takes at least a byte of what is left of the file
+int readLength(std::istream &in) {
+    int length = readValue<int>(in);
+    std::streampos here = in.tellg();
+    in.seekg(0, std::ios::end);
+    std::streamoff left = in.tellg() - here;
+    in.seekg(here);
+    if (length < 0 || length > left) {
+        throw CorruptCheckpointException("The checkpoint holds an invalid length: " + std::to_string(length) + ".");
+    }
+    return length;
+}
+
+void writeString(std::ostream &out, const std::string &str) {
+    writeValue<int>(out, str.size());
+    out.write(str.data(), str.size());
+}
+
+std::string readString(std::istream &in) {
+    std::string str(readLength(in), ' ');
+    in.read(&str[0], str.size());
+    return str;
+}
+
+// An LTR only needs its coordinates and direction; its stretches and their heights are not used after filtering
+void writeLTR(std::ostream &out, const Element *ltr) {
+    writeValue<int>(out, ltr->getStart());
+    writeValue<int>(out, ltr->getEnd());
+    writeValue<bool>(out, ltr->getIsForward());
+}
+
+Element *readLTR(std::istream &in) {
+    int start = readValue<int>(in);
+    int end = readValue<int>(in);
+    bool isForward = readValue<bool>(in);
+    return new Element(start, end, 1, isForward);
+}
+
+void writeIndexes(std::ostream &out, const std::set<RT*> &rtSet, std::unordered_map<RT*, int> &indexTable) {
+    writeValue<int>(out, rtSet.size());
+    for (auto rt : rtSet) {
+        auto itr = indexTable.find(rt);
+        writeValue<int>(out, itr == indexTable.end() ? -1 : itr->second);
+    }
+}
+
+std::vector<int> readIndexes(std::istream &in, int rtCount) {
+    std::vector<int> r(readLength(in));
+    for (auto &index : r) {
+        index = readValue<int>(in);
+        if (index >= rtCount) {
+            throw CorruptCheckpointException("The checkpoint refers to a missing LTR RT.");
+        }
+    }
+    return r;
+}
+
+}
+
+Checkpoint::Checkpoint(std::string outPath, std::string _fingerprint, bool resume) : fingerprint(_fingerprint)
+{
+    dirPath = outPath + "checkpoint/";
+    manifestPath = dirPath + "manifest.txt";
+    std::string header = "look4ltrs checkpoint " + std::to_string(VERSION);
+
+    bool isResumed = false;
+    if (resume && std::filesystem::exists(manifestPath)) {
+        std::ifstream in{manifestPath};
+        std::string line;
+        std::string oldFingerprint;
+        bool isSame = std::getline(in, line) && line == header;
+        while (isSame && std::getline(in, line) && line != "") {
+            oldFingerprint += line + "\n";
+        }
+        if (isSame && oldFingerprint == fingerprint) {
+            // A line cut short by a crash has no newline; it is dropped
+            while (std::getline(in, line)) {
+                if (!in.eof()) {
+                    doneSet.insert(line);
+                }
+            }
+            isResumed = true;
+        }
+        else {
+            std::cout << "The checkpoint in " << dirPath << " is of other input; starting over." << std::endl;
+        }
+    }
+
+    if (isResumed) {
+        std::cout << "Resuming from " << dirPath << " with " << doneSet.size() << " finished stages." << std::endl;
+    }
+    else {
+        std::filesystem::remove_all(dirPath);
+        std::filesystem::create_directory(dirPath);
+        std::ofstream out{manifestPath};
+        out << header << std::endl << fingerprint << std::endl;
+    }
+}
+
+std::string Checkpoint::makeKey(const std::string &stage, int chromID) const {
+    return chromID < 0 ? stage : stage + " " + std::to_string(chromID);
+}
+
+std::string Checkpoint::getDirPath() const {
+    return dirPath;
+}
+
+std::string Checkpoint::getPath(const std::string &stage, int chromID) const {
+    return dirPath + stage + "_" + std::to_string(chromID) + ".bin";
+}
+
+bool Checkpoint::isDone(const std::string &stage, int chromID) const {
+    return doneSet.count(makeKey(stage, chromID)) == 1;
+}
+
+void Checkpoint::markDone(const std::string &stage, int chromID) {
+    std::lock_guard<std::mutex> lock(mtx);
+    std::string key = makeKey(stage, chromID);
+    doneSet.insert(key);
+    std::ofstream out{manifestPath, std::ios::app};
+    out << key << std::endl;
+}
+
+void Checkpoint::remove() {
+    std::filesystem::remove_all(dirPath);
+}
+
+void Checkpoint::writeElements(std::ostream &out, const std::vector<Element> &eleVec) {
+    writeValue<int>(out, eleVec.size());
+    for (auto &ele : eleVec) {
+        writeValue<int>(out, ele.getStart());
+        writeValue<int>(out, ele.getEnd());
+        auto stretchVec = ele.getStretchVec();
+        writeValue<int>(out, stretchVec.size());
+        for (auto s : stretchVec) {
+            writeValue<int>(out, s->getStart());
+            writeValue<int>(out, s->getEnd());
+            writeValue<int>(out, s->getMark());
+            writeValue<int>(out, s->getMedianHeight());
+            writeValue<bool>(out, s->getIsForward());
+        }
+    }
+}
+
+std::vector<Element> Checkpoint::readElements(std::istream &in, std::vector<Stretch*> &heapStretchVec) {
+    std::vector<Element> r;
+    int eleCount = readLength(in);
+    r.reserve(eleCount);
+    for (int i = 0; i < eleCount; i++) {
+        int start = readValue<int>(in);
+        int end = readValue<int>(in);
+        int stretchCount = readLength(in);
+        if (stretchCount == 0) {
+            throw CorruptCheckpointException("The checkpoint holds an element without stretches.");
+        }
+
+        std::vector<Stretch*> stretchVec;
+        for (int j = 0; j < stretchCount; j++) {
+            int sStart = readValue<int>(in);
+            int sEnd = readValue<int>(in);
+            int mark = readValue<int>(in);
+            int medianHeight = readValue<int>(in);
+            bool isForward = readValue<bool>(in);
+            Stretch *s = new Stretch{sStart, sEnd, mark, isForward};
+            s->setMedianHeight(medianHeight);
+            stretchVec.push_back(s);
+            heapStretchVec.push_back(s);
+        }
+
+        // Merging keeps the order of the stretches; the bounds are set afterwards because the detector may have moved them
+        Element e{*stretchVec.at(0)};
+        for (int j = 1; j < stretchCount; j++) {
+            e.merge(*stretchVec.at(j));
+        }
+        e.setStart(start);
+        e.setEnd(end);
+        r.push_back(e);
+    }
+    return r;
+}
+
+void Checkpoint::writeRTs(std::ostream &out, const std::vector<RT*> &rtVec, const std::vector<RT*> &complexVec) {
+    std::unordered_map<RT*, int> indexTable;
+    for (int i = 0; i < rtVec.size(); i++) {
+        indexTable[rtVec[i]] = i;
+    }
+
+    writeValue<int>(out, rtVec.size());
+    for (auto rt : rtVec) {
+        writeValue<bool>(out, rt->hasRightLTR());
+        writeString(out, rt->getCaseType());
+        writeValue<int>(out, rt->getCaseRank());
+        writeValue<int>(out, rt->getGraphGroup());
+        writeLTR(out, rt->getLeftLTR());
+        if (rt->hasRightLTR()) {
+            writeLTR(out, rt->getRightLTR());
+            writeValue<bool>(out, rt->getIsRC());
+            writeValue<int>(out, rt->getPPTStart());
+            writeValue<int>(out, rt->getPPTEnd());
+            writeValue<bool>(out, rt->getIsTSDExist());
+            writeValue<int>(out, rt->getLeftTSD().first);
+            writeValue<int>(out, rt->getLeftTSD().second);
+            writeValue<int>(out, rt->getRightTSD().first);
+            writeValue<int>(out, rt->getRightTSD().second);
+            writeValue<double>(out, rt->getIdentityScore());
+        }
+    }
+
+    // Nesting refers to the LTR RTs by their index
+    for (auto rt : rtVec) {
+        writeIndexes(out, rt->hasRightLTR() ? rt->getNestSet() : std::set<RT*>(), indexTable);
+        writeIndexes(out, rt->getOuterSet(), indexTable);
+    }
+
+    writeValue<int>(out, complexVec.size());
+    for (auto cpx : complexVec) {
+        writeString(out, cpx->getCaseType());
+        writeValue<int>(out, cpx->getCaseRank());
+        writeValue<int>(out, cpx->getGraphGroup());
+        auto ltrVec = cpx->getLTRVec();
+        writeValue<int>(out, ltrVec.size());
+        for (auto ltr : ltrVec) {
+            writeLTR(out, ltr);
+        }
+    }
+}
+
+void Checkpoint::readRTs(std::istream &in, std::vector<RT*> &rtVec, std::vector<RT*> &complexVec) {
+    std::vector<std::unique_ptr<RT>> readRtVec;
+    int rtCount = readLength(in);
+    for (int i = 0; i < rtCount; i++) {
+        bool isComplete = readValue<bool>(in);
+        std::string caseType = readString(in);
+        int caseRank = readValue<int>(in);
+        int graphGroup = readValue<int>(in);
+        std::unique_ptr<Element> leftLTR{readLTR(in)};
+        if (isComplete) {
+            std::unique_ptr<Element> rightLTR{readLTR(in)};
+            RTComplete *rt = new RTComplete(leftLTR.release(), rightLTR.release(), caseType, caseRank, graphGroup);
+            readRtVec.emplace_back(rt);
+            rt->setIsRC(readValue<bool>(in));
+            int PPTStart = readValue<int>(in);
+            int PPTEnd = readValue<int>(in);
+            bool isTSDExist = readValue<bool>(in);
+            std::pair<int, int> leftTSD;
+            leftTSD.first = readValue<int>(in);
+            leftTSD.second = readValue<int>(in);
+            std::pair<int, int> rightTSD;
+            rightTSD.first = readValue<int>(in);
+            rightTSD.second = readValue<int>(in);
+            rt->restore(PPTStart, PPTEnd, isTSDExist, leftTSD, rightTSD);
+            rt->setIdentityScore(readValue<double>(in));
+        }
+        else {
+            readRtVec.emplace_back(new RTSolo(leftLTR.release(), caseType, caseRank, graphGroup));
+        }
+    }
+
+    std::vector<std::vector<int>> nestIndexVec;
+    std::vector<std::vector<int>> outerIndexVec;
+    for (int i = 0; i < rtCount; i++) {
+        nestIndexVec.push_back(readIndexes(in, rtCount));
+        outerIndexVec.push_back(readIndexes(in, rtCount));
+    }
+
+    std::vector<std::unique_ptr<RT>> readComplexVec;
+    int complexCount = readLength(in);
+    for (int i = 0; i < complexCount; i++) {
+        std::string caseType = readString(in);
+        int caseRank = readValue<int>(in);
+        int graphGroup = readValue<int>(in);
+        std::vector<std::unique_ptr<Element>> ltrVec(readLength(in));
+        for (auto &ltr : ltrVec) {
+            ltr.reset(readLTR(in));
+        }
+        std::vector<Element*> rawLtrVec;
+        for (auto &ltr : ltrVec) {
+            rawLtrVec.push_back(ltr.release());
+        }
+        readComplexVec.emplace_back(new RTComplex(rawLtrVec, caseType, caseRank, graphGroup));
+    }
+
+    // The whole file is read; nesting last, so a damaged file leaves no RT pointing at another
+    for (int i = 0; i < rtCount; i++) {
+        RT *rt = readRtVec.at(i).get();
+        for (int index : nestIndexVec.at(i)) {
+            if (index >= 0) {
+                rt->nest(readRtVec.at(index).get());
+            }
+        }
+        for (int index : outerIndexVec.at(i)) {
+            if (index >= 0) {
+                rt->addOuter(readRtVec.at(index).get());
+            }
+        }
+    }
+    for (auto &rt : readRtVec) {
+        rtVec.push_back(rt.release());
+    }
+    for (auto &cpx : readComplexVec) {
+        complexVec.push_back(cpx.release());
+    }
+}
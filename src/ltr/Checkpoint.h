@@ -0,0 +1,113 @@
+/*
+ * LtrDetector v2.0 annotates LTR retro-transposons in a genome.
+ *
+ * Checkpoint
+ *
+ *  Created on: Oct 17, 2026
+ * Reviewer:
+ *   Purpose: Records which per-chromosome stages of look4ltrs are finished, so --resume can skip them.
+ *            The manifest lists the finished stages; each stage's output is a binary file next to it.
+ *            A stage is only listed after its file is completely written.
+ *
+ * Academic use: Affero General Public License version 1.
+ *
+ * Any restrictions to use for-profit or non-academics: Alternative commercial license is needed.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Please contact Dr. Hani Z. Girgis (hzgirgis@buffalo.edu) if you need more information.
+ *
+ * Copyright (C) 2022 by the authors.
+ */
+
+#pragma once
+
+#include "Element.h"
+#include "Stretch.h"
+#include "RT.h"
+#include "RTComplete.h"
+#include "RTSolo.h"
+#include "RTComplex.h"
+
+#include <string>
+#include <vector>
+#include <set>
+#include <mutex>
+#include <fstream>
+#include <iostream>
+#include <filesystem>
+#include <stdexcept>
+
+// Thrown when a checkpoint file is truncated or does not hold what its stage wrote
+class CorruptCheckpointException : public std::runtime_error
+{
+public:
+    using std::runtime_error::runtime_error;
+};
+
+class Checkpoint
+{
+private:
+    // Variables
+    std::string dirPath;
+    std::string manifestPath;
+
+    // Describes the input; checkpoints of another input are never resumed
+    std::string fingerprint;
+
+    // "stage" or "stage chromID" for every finished stage
+    std::set<std::string> doneSet;
+
+    std::mutex mtx;
+
+    // Methods
+    std::string makeKey(const std::string &stage, int chromID) const;
+
+public:
+    // Increase whenever the layout of the manifest or of the binary files changes
+    static const int VERSION = 1;
+
+    // Constructor
+
+    /**
+     * Checkpoints go to outPath/checkpoint/. If resume is true and the manifest there
+     * was written for the same fingerprint, its finished stages are kept; otherwise
+     * the directory is cleared.
+     */
+    Checkpoint(std::string outPath, std::string _fingerprint, bool resume);
+
+    Checkpoint(const Checkpoint &) = delete;
+    Checkpoint &operator=(const Checkpoint &) = delete;
+
+    // Getter and Setters
+    std::string getDirPath() const;
+
+    // The binary file of a per-chromosome stage
+    std::string getPath(const std::string &stage, int chromID) const;
+
+    // Methods
+    bool isDone(const std::string &stage, int chromID = -1) const;
+
+    // Appends the stage to the manifest; safe to call from several threads
+    void markDone(const std::string &stage, int chromID = -1);
+
+    // Called once the run has finished and its output is written
+    void remove();
+
+    /**
+     * Elements keep their stretches; the stretches read back are allocated on the heap
+     * and appended to heapStretchVec, which owns them.
+     * The readers throw CorruptCheckpointException on a damaged file.
+     */
+    static void writeElements(std::ostream &out, const std::vector<Element> &eleVec);
+    static std::vector<Element> readElements(std::istream &in, std::vector<Stretch*> &heapStretchVec);
+
+    /**
+     * The LTR RTs and the complex regions of a chromosome, with their nesting.
+     * The RTs read back are allocated on the heap; the caller owns them.
+     * Nothing is added to the vectors if the file is damaged.
+     */
+    static void writeRTs(std::ostream &out, const std::vector<RT*> &rtVec, const std::vector<RT*> &complexVec);
+    static void readRTs(std::istream &in, std::vector<RT*> &rtVec, std::vector<RT*> &complexVec);
+};
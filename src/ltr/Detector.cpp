@@ -31,17 +31,27 @@
 Detector::Detector(Red &_red, std::string &_seq)
     : red(_red), seq(_seq), meanVec(LtrParameters::MEAN_VECTOR), stdVec(LtrParameters::STD_VECTOR), classifier(LtrParameters::WEIGHT_VECTOR)
 {
-    scoreVec = red.score(seq);
+    ownedScoreTrack = std::make_unique<RedScoreTrack>(red.scoreTrack(seq));
+    scoreTrack = ownedScoreTrack.get();
     locationVec = red.predictRepeats(seq);
 }
 
 Detector::Detector(Red &_red, std::string &_seq, std::string &otherSeq)
     : red(_red), seq(_seq), meanVec(LtrParameters::MEAN_VECTOR), stdVec(LtrParameters::STD_VECTOR), classifier(LtrParameters::WEIGHT_VECTOR)
 {
-    scoreVec = red.score(otherSeq); 
+    ownedScoreTrack = std::make_unique<RedScoreTrack>(red.scoreTrack(otherSeq));
+    scoreTrack = ownedScoreTrack.get();
     locationVec = red.predictRepeats(otherSeq); 
 }
 
+Detector::Detector(Red &_red, std::string &_seq, const RedScoreTrack &_scoreTrack)
+    : red(_red), seq(_seq), meanVec(LtrParameters::MEAN_VECTOR), stdVec(LtrParameters::STD_VECTOR), classifier(LtrParameters::WEIGHT_VECTOR)
+{
+    assert(_scoreTrack.getLength() == seq.size());
+    scoreTrack = &_scoreTrack;
+    locationVec = red.predictRepeats(seq);
+}
+
 // [OK]
 Detector::~Detector()
 {
@@ -192,15 +202,16 @@ Matrix Detector::buildMatrix(std::vector<Stretch> &stretchVec)
             r(i, 3) = std::abs(stretchVec[i].getMedianHeight() - stretchVec[i + 1].getMedianHeight());
 
             // Extract Red scores
-            std::vector<int> firstStretch(scoreVec.begin() + stretchVec[i].getStart(), scoreVec.begin() + stretchVec[i].getEnd());
-            std::vector<int> secondStretch(scoreVec.begin() + stretchVec[i + 1].getStart(), scoreVec.begin() + stretchVec[i + 1].getEnd());
-            std::vector<int> gapStretch(scoreVec.begin() + stretchVec[i].getEnd(), scoreVec.begin() + stretchVec[i + 1].getStart());
+            int firstStart = stretchVec[i].getStart();
+            int firstEnd = stretchVec[i].getEnd();
+            int secondStart = stretchVec[i + 1].getStart();
+            int secondEnd = stretchVec[i + 1].getEnd();
 
-            double firstMean = LtrUtility::calcMean(firstStretch);
-            double secondMean = LtrUtility::calcMean(secondStretch);
-            double gapMean = gapStretch.size() > 0 ? LtrUtility::calcMean(gapStretch) : 0.0;
+            double firstMean = scoreTrack->calcMean(firstStart, firstEnd);
+            double secondMean = scoreTrack->calcMean(secondStart, secondEnd);
+            double gapMean = secondStart > firstEnd ? scoreTrack->calcMean(firstEnd, secondStart) : 0.0;
 
-            r(i, 4) = std::abs(LtrUtility::calcMedian(firstStretch) - LtrUtility::calcMedian(secondStretch));
+            r(i, 4) = std::abs(scoreTrack->calcMedian(firstStart, firstEnd) - scoreTrack->calcMedian(secondStart, secondEnd));
             r(i, 5) = std::abs(firstMean - secondMean);
             r(i, 6) = firstMean;
             r(i, 7) = secondMean;
@@ -38,6 +38,7 @@
 #include "assert.h"
 #include <string>
 #include <unordered_map>
+#include <memory>
 
 class Detector {
     public:
@@ -47,6 +48,8 @@ class Detector {
          */
         Detector(Red &_red, std::string &_seq);
         Detector(Red &_red, std::string &_seq, std::string &otherSeq);
+        // Reads Red's scores of seq from a track the caller keeps
+        Detector(Red &_red, std::string &_seq, const RedScoreTrack &_scoreTrack);
         ~Detector();
 
         /**
@@ -85,7 +88,8 @@ class Detector {
         std::vector<double> &meanVec;
         std::vector<double> &stdVec;
 
-        std::vector<int> scoreVec;
+        const RedScoreTrack *scoreTrack;
+        std::unique_ptr<RedScoreTrack> ownedScoreTrack;
         const std::vector<utility::ILocation *> *locationVec;
 
         std::vector<int> prediction;
@@ -0,0 +1,65 @@
+/*
+ * LtrDetector v2.0 annotates LTR retro-transposons in a genome.
+ * 
+ * ElementDB
+ * 
+ *  Created on: Oct 17, 2026
+ * Reviewer:
+ *   Purpose: In-memory database of detected elements for training Identity.
+ * 
+ * Academic use: Affero General Public License version 1.
+ *
+ * Any restrictions to use for-profit or non-academics: Alternative commercial license is needed.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * 
+ * Please contact Dr. Hani Z. Girgis (hzgirgis@buffalo.edu) if you need more information.
+ * 
+ * Copyright (C) 2022 by the authors.
+ */
+
+#include "ElementDB.h"
+
+ElementDB::ElementDB(const GenomeStore &_store) : store(_store)
+{
+
+}
+
+int ElementDB::getSize() const {
+    return spanVec.size();
+}
+
+void ElementDB::add(int chromID, int start, int end) {
+    spanVec.push_back(Span{chromID, start, end});
+}
+
+bool ElementDB::isAllUnknown(const std::string &chromosome, int start, int end) const {
+    char unknown = Parameters::getUnknown();
+    for (int i = start; i < end; i++) {
+        if (chromosome[i] != unknown) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Block *ElementDB::makeBlock(int blockSize) const {
+    Block *block = new Block();
+    int dbID = 0;
+    for (auto &span : spanVec) {
+        if (block->size() >= blockSize) {
+            break;
+        }
+
+        const std::string &chromosome = *store.getSequence(span.chromID);
+        if (!isAllUnknown(chromosome, span.start, span.end)) {
+            std::string *info = new std::string(">" + std::to_string(store.getFastaID(span.chromID)) + "_" + store.getName(span.chromID) + "_" + std::to_string(dbID));
+            std::string *base = new std::string(chromosome.substr(span.start, span.end - span.start));
+            block->push_back(std::make_pair(info, base));
+        }
+        dbID++;
+    }
+    block->shrink_to_fit();
+    return block;
+}
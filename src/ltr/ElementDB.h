@@ -0,0 +1,71 @@
+/*
+ * LtrDetector v2.0 annotates LTR retro-transposons in a genome.
+ * 
+ * ElementDB
+ * 
+ *  Created on: Oct 17, 2026
+ * Reviewer:
+ *   Purpose: In-memory database of detected elements for training Identity.
+ *            Elements are kept as spans into the GenomeStore chromosomes; only the
+ *            sequences Identity trains on are copied out, into a FastaReader Block.
+ * 
+ * Academic use: Affero General Public License version 1.
+ *
+ * Any restrictions to use for-profit or non-academics: Alternative commercial license is needed.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * 
+ * Please contact Dr. Hani Z. Girgis (hzgirgis@buffalo.edu) if you need more information.
+ * 
+ * Copyright (C) 2022 by the authors.
+ */
+
+#pragma once
+
+#include "GenomeStore.h"
+#include "../FastaReader.h"
+#include "../Parameters.h"
+
+#include <string>
+#include <vector>
+
+class ElementDB
+{
+private:
+    struct Span {
+        int chromID;
+        int start;
+        int end;
+    };
+
+    // Variables
+    const GenomeStore &store;
+    std::vector<Span> spanVec;
+
+    // Methods
+    bool isAllUnknown(const std::string &chromosome, int start, int end) const;
+
+public:
+    
+    // Constructor
+    ElementDB(const GenomeStore &_store);
+
+    // Getter and Setters
+    int getSize() const;
+
+    // Methods
+
+    /**
+     * Appends an element; elements are kept in the order they are added,
+     * which is the order db.fasta used to be written in.
+     */
+    void add(int chromID, int start, int end);
+
+    /**
+     * Copies the first blockSize elements into a new block, skipping elements made only of
+     * unknown nucleotides, exactly like FastaReader reading the first block of db.fasta.
+     * The caller owns the block.
+     */
+    Block *makeBlock(int blockSize = Parameters::getBlockSize()) const;
+};
@@ -25,7 +25,7 @@
 
 #include "Filter.h"
 
-Filter::Filter(std::vector<RT*> &_rtVec, Red &_red, std::string *_seq) : rtVec(_rtVec), red(_red), seq(_seq)
+Filter::Filter(std::vector<RT*> &_rtVec, const RedScoreTrack &_redTrack, std::string *_seq) : rtVec(_rtVec), redTrack(_redTrack), seq(_seq)
 {
 }
 
@@ -461,34 +461,25 @@ void Filter::filterRepetivity() {
         // Right LTR repetivity
         // Interior (no nested elements) repetivitiy
         bool isFail = true;
-        auto rtScoreVec = scoreSeq(rtPtr->getStart(), rtPtr->getEnd());
-
-        auto s1 = rtScoreVec.begin();
-        auto s2 = s1 + rtPtr->getLeftLTR()->getSize();
-        
-
-        std::vector<int> leftLtrScoreVec{s1, s2};
-        bool isLeftLtrRep = LtrUtility::calcPercent(leftLtrScoreVec) >= LtrParameters::MIN_PERC;
+        Range rangeVec = rtPtr->getRange();
+        auto leftLtr = rangeVec.front();
+        bool isLeftLtrRep = redTrack.calcPercent(leftLtr.first, leftLtr.second) >= LtrParameters::MIN_PERC;
 
         if (isLeftLtrRep) {
             if (rtPtr->hasRightLTR()) {
 
-                auto s3 = s2 + rtPtr->getRightLTR()->getStart() - rtPtr->getLeftLTR()->getEnd();
-                
-                std::vector<int> rightLtrScoreVec{s3, rtScoreVec.end()};
-                bool isRightLtrRep = LtrUtility::calcPercent(rightLtrScoreVec) >= LtrParameters::MIN_PERC;
+                auto rightLtr = rangeVec.back();
+                bool isRightLtrRep = redTrack.calcPercent(rightLtr.first, rightLtr.second) >= LtrParameters::MIN_PERC;
 
                 // First and last index contains the LTR ranges
-                Range rangeVec = rtPtr->getRange();
                 assert(rangeVec.size() >= 3);
 
-                int start = rtPtr->getStart();
-                std::vector<int> interiorScoreVec;
-                for (int i = 1; i < rangeVec.size() - 1; i++) {
-                    auto locs = rangeVec.at(i);
-                    interiorScoreVec.insert(interiorScoreVec.end(), rtScoreVec.begin() + locs.first - start , rtScoreVec.begin() + locs.second - start);
+                Range interiorVec{rangeVec.begin() + 1, rangeVec.end() - 1};
+                int interiorSize = 0;
+                for (auto &locs : interiorVec) {
+                    interiorSize += locs.second - locs.first;
                 }
-                bool isInteriorRep =interiorScoreVec.size() > LtrParameters::MIN_INTERIOR ? LtrUtility::calcPercent(interiorScoreVec) >= LtrParameters::MIN_PERC : false;
+                bool isInteriorRep = interiorSize > LtrParameters::MIN_INTERIOR ? redTrack.calcPercent(interiorVec) >= LtrParameters::MIN_PERC : false;
 
                 if (isRightLtrRep && isInteriorRep) {
                     isFail = false;
@@ -787,10 +778,6 @@ void Filter::removeNests(RT* rtPtr) {
 
 }
 
-std::vector<int> Filter::scoreSeq(int s, int e) {
-    std::string region = seq->substr(s, e - s);
-    return red.score(region);
-}
 
 
 std::vector<RT*> Filter::getRtVec() {
@@ -29,7 +29,7 @@
 #include "LtrParameters.h"
 #include "LtrUtility.h"
 
-#include "../red/Red.h"
+#include "../red/RedScoreTrack.h"
 #include "LocalAlignment.h"
 
 #include <vector>
@@ -48,7 +48,7 @@ class Filter
 private:
     // Variables
     std::vector<RT*>& rtVec;
-    Red& red;
+    const RedScoreTrack &redTrack;
     std::string *seq;
     // Methods
 
@@ -94,7 +94,6 @@ private:
     // If a RT is to be filtered out, remove all connections to and fro other RTs
     void removeNests(RT *rt);
 
-    std::vector<int> scoreSeq(int s, int e);
 
 
 
@@ -103,7 +102,7 @@ public:
     // Constructor
 
     // rtVec should be a vector of RT pointers, i.e., the candidate LTR RTs.
-    Filter(std::vector<RT*> &_rtVec, Red &_red, std::string *_seq);
+    Filter(std::vector<RT*> &_rtVec, const RedScoreTrack &_redTrack, std::string *_seq);
 
     // Getter and Setters
     std::vector<RT*> getRtVec();
@@ -0,0 +1,154 @@
+/*
+ * LtrDetector v2.0 annotates LTR retro-transposons in a genome.
+ * 
+ * GenomeStore
+ * 
+ *  Created on: Oct 17, 2026
+ * Reviewer:
+ *   Purpose: Reads every FASTA file once and keeps its chromosomes in memory.
+ * 
+ * Academic use: Affero General Public License version 1.
+ *
+ * Any restrictions to use for-profit or non-academics: Alternative commercial license is needed.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * 
+ * Please contact Dr. Hani Z. Girgis (hzgirgis@buffalo.edu) if you need more information.
+ * 
+ * Copyright (C) 2022 by the authors.
+ */
+
+#include "GenomeStore.h"
+
+/**
+ * _fastaVec: the FASTA files; a file's index in this vector is its fasta ID
+ * threadNum: number of files parsed at the same time
+ */
+GenomeStore::GenomeStore(const std::vector<std::string> &_fastaVec, int threadNum) : fastaVec(_fastaVec)
+{
+    // Each file is parsed by its own thread; a file may hold more than one block of sequences
+    std::vector<std::vector<Block*>> blockVec(fastaVec.size());
+    #pragma omp parallel for schedule(dynamic) num_threads(threadNum)
+    for (int i = 0; i < fastaVec.size(); i++) {
+        #pragma omp critical
+        {
+            std::cout << "Parsing " + fastaVec.at(i) << std::endl;
+        }
+        FastaReader fr(fastaVec.at(i), 1000);
+        while (fr.isStillReading()) {
+            blockVec.at(i).push_back(fr.read());
+        }
+    }
+
+    // Assigning the IDs in file order; the store takes over the sequences
+    fastaChromVec.resize(fastaVec.size());
+    for (int i = 0; i < blockVec.size(); i++) {
+        for (auto block : blockVec.at(i)) {
+            for (auto &chrom : *block) {
+                fastaChromVec.at(i).push_back(seqVec.size());
+                fastaIDVec.push_back(i);
+                nameVec.push_back(chrom.first->substr(1));
+                seqVec.push_back(chrom.second);
+
+                delete chrom.first;
+            }
+            block->clear();
+            delete block;
+        }
+    }
+
+    // Elements and window offsets are ints, so a longer chromosome can not be annotated
+    for (int c = 0; c < seqVec.size(); c++) {
+        if (seqVec.at(c)->size() > std::numeric_limits<int>::max()) {
+            std::string msg = "The chromosome " + nameVec.at(c) + " of " + fastaVec.at(fastaIDVec.at(c)) + " has "
+                + std::to_string(seqVec.at(c)->size()) + " bases; at most " + std::to_string(std::numeric_limits<int>::max())
+                + " bases are supported.";
+            for (auto &seq : seqVec) {
+                delete seq;
+            }
+            throw std::length_error(msg);
+        }
+    }
+}
+
+GenomeStore::~GenomeStore()
+{
+    for (auto &seq : seqVec) {
+        delete seq;
+        seq = nullptr;
+    }
+}
+
+int GenomeStore::getFastaCount() const {
+    return fastaVec.size();
+}
+
+int GenomeStore::getChromCount() const {
+    return seqVec.size();
+}
+
+int GenomeStore::findFasta(const std::string &fastaPath) const {
+    auto it = std::find(fastaVec.begin(), fastaVec.end(), fastaPath);
+    return it == fastaVec.end() ? -1 : it - fastaVec.begin();
+}
+
+const std::string &GenomeStore::getFastaPath(int fastaID) const {
+    return fastaVec.at(fastaID);
+}
+
+const std::vector<int> &GenomeStore::getChromIDs(int fastaID) const {
+    return fastaChromVec.at(fastaID);
+}
+
+int GenomeStore::getFastaID(int chromID) const {
+    return fastaIDVec.at(chromID);
+}
+
+const std::string &GenomeStore::getName(int chromID) const {
+    return nameVec.at(chromID);
+}
+
+long long GenomeStore::getSize(int chromID) const {
+    return seqVec.at(chromID)->size();
+}
+
+long long GenomeStore::getTotalSize() const {
+    long long r = 0;
+    for (auto seq : seqVec) {
+        r += seq->size();
+    }
+    return r;
+}
+
+std::string *GenomeStore::getSequence(int chromID) const {
+    return seqVec.at(chromID);
+}
+
+std::vector<GenomeStore::Window> GenomeStore::makeWindows(int chromID, int windowSize, int overlap) const {
+    // The constructor rejects chromosomes past the int limit
+    int size = static_cast<int>(getSize(chromID));
+    std::vector<Window> r;
+    if (windowSize <= 0 || size <= windowSize) {
+        r.push_back(Window{chromID, 0, size, 0, size});
+        return r;
+    }
+    assert(windowSize > 2 * overlap);
+
+    int step = windowSize - overlap;
+    for (int offset = 0; ; offset += step) {
+        // The sum can pass the int limit on the longest chromosomes
+        int end = static_cast<int>(std::min<long long>(size, static_cast<long long>(offset) + windowSize));
+        r.push_back(Window{chromID, offset, end - offset, offset, end});
+        if (end == size) {
+            break;
+        }
+    }
+
+    for (int w = 1; w < r.size(); w++) {
+        int seam = r[w].offset + (r[w - 1].offset + r[w - 1].length - r[w].offset) / 2;
+        r[w - 1].coreEnd = seam;
+        r[w].coreStart = seam;
+    }
+    return r;
+}
@@ -0,0 +1,109 @@
+/*
+ * LtrDetector v2.0 annotates LTR retro-transposons in a genome.
+ * 
+ * GenomeStore
+ * 
+ *  Created on: Oct 17, 2026
+ * Reviewer:
+ *   Purpose: Reads every FASTA file once and keeps its chromosomes in memory.
+ *            Each chromosome has a stable ID, its index in the order of the files
+ *            and of the chromosomes within a file. All look4ltrs phases read from here.
+ * 
+ * Academic use: Affero General Public License version 1.
+ *
+ * Any restrictions to use for-profit or non-academics: Alternative commercial license is needed.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * 
+ * Please contact Dr. Hani Z. Girgis (hzgirgis@buffalo.edu) if you need more information.
+ * 
+ * Copyright (C) 2022 by the authors.
+ */
+
+#pragma once
+
+#include "../FastaReader.h"
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <assert.h>
+
+class GenomeStore
+{
+public:
+    /**
+     * A stretch of a chromosome processed as one task. Neighboring windows overlap;
+     * the core is the part of the chromosome this window answers for, so every
+     * position belongs to the core of exactly one window.
+     */
+    struct Window
+    {
+        int chromID;
+        int offset;
+        int length;
+        int coreStart;
+        int coreEnd;
+    };
+
+private:
+    // Variables
+    std::vector<std::string> fastaVec;
+
+    // fasta ID -> IDs of its chromosomes in file order
+    std::vector<std::vector<int>> fastaChromVec;
+
+    // chromosome ID -> fasta ID
+    std::vector<int> fastaIDVec;
+
+    // chromosome ID -> header without the '>'
+    std::vector<std::string> nameVec;
+
+    // chromosome ID -> sequence
+    std::vector<std::string*> seqVec;
+
+public:
+    
+    // Constructor
+    // Throws std::length_error if a chromosome is longer than an int can index
+    GenomeStore(const std::vector<std::string> &_fastaVec, int threadNum);
+    ~GenomeStore();
+
+    GenomeStore(const GenomeStore &) = delete;
+    GenomeStore &operator=(const GenomeStore &) = delete;
+
+    // Getter and Setters
+    int getFastaCount() const;
+    int getChromCount() const;
+
+    // Returns -1 if the file was not read into the store
+    int findFasta(const std::string &fastaPath) const;
+    const std::string &getFastaPath(int fastaID) const;
+    const std::vector<int> &getChromIDs(int fastaID) const;
+
+    int getFastaID(int chromID) const;
+    const std::string &getName(int chromID) const;
+    long long getSize(int chromID) const;
+
+    // Total number of bases held by the store
+    long long getTotalSize() const;
+
+    /**
+     * The sequence is shared by every thread; callers must not modify it.
+     * It is handed out as a plain pointer because the modules take std::string*.
+     */
+    std::string *getSequence(int chromID) const;
+
+    // Methods
+
+    /**
+     * Splits a chromosome longer than windowSize into windows of windowSize that overlap
+     * by overlap bases; the cores meet in the middle of the overlaps.
+     * A shorter chromosome, or a windowSize of 0, gives one window over the whole chromosome.
+     */
+    std::vector<Window> makeWindows(int chromID, int windowSize, int overlap) const;
+};
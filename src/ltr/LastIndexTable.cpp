@@ -0,0 +1,71 @@
+/*
+ * LtrDetector v2.0 annotates LTR retro-transposons in a genome.
+ * 
+ * LastIndexTable
+ * 
+ *  Created on: Oct 17, 2026
+ * Reviewer:
+ *   Purpose: The last index of every k-mer, reused by every sequence a thread scores.
+ * 
+ * Academic use: Affero General Public License version 1.
+ *
+ * Any restrictions to use for-profit or non-academics: Alternative commercial license is needed.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * 
+ * Please contact Dr. Hani Z. Girgis (hzgirgis@buffalo.edu) if you need more information.
+ * 
+ * Copyright (C) 2022 by the authors.
+ */
+
+#include "LastIndexTable.h"
+
+LastIndexTable::LastIndexTable(int _k) : k(_k), table(1ULL << (2 * _k), 0), base(1), length(0)
+{
+    assert(_k >= 1 && _k <= 15);
+}
+
+std::unique_ptr<LastIndexTable> &LastIndexTable::getThreadTable() {
+    thread_local std::unique_ptr<LastIndexTable> threadTable;
+    return threadTable;
+}
+
+LastIndexTable &LastIndexTable::forThread(int k) {
+    auto &threadTable = getThreadTable();
+    if (threadTable == nullptr || threadTable->getK() != k) {
+        threadTable.reset();
+        threadTable = std::make_unique<LastIndexTable>(k);
+    }
+    return *threadTable;
+}
+
+void LastIndexTable::releaseThreadTable() {
+    getThreadTable().reset();
+}
+
+int LastIndexTable::getK() const {
+    return k;
+}
+
+SparseLastIndexTable::SparseLastIndexTable(int length)
+{
+    uint32_t capacity = 16;
+    while (capacity < 2ULL * length) {
+        capacity <<= 1;
+    }
+    slotVec.assign(capacity, {-1, 0});
+    mask = capacity - 1;
+}
+
+void LastIndexTable::reset(int _length) {
+    assert(_length >= 0);
+    // Entries of the last sequence are below base + length; they all fall under the new base
+    uint64_t next = static_cast<uint64_t>(base) + length;
+    if (next + _length > std::numeric_limits<uint32_t>::max()) {
+        std::fill(table.begin(), table.end(), 0);
+        next = 1;
+    }
+    base = static_cast<uint32_t>(next);
+    length = _length;
+}
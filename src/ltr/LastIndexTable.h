@@ -0,0 +1,125 @@
+/*
+ * LtrDetector v2.0 annotates LTR retro-transposons in a genome.
+ * 
+ * LastIndexTable
+ * 
+ *  Created on: Oct 17, 2026
+ * Reviewer:
+ *   Purpose: The last index of every k-mer, as ScorerTr needs it, reused by every sequence a thread scores.
+ *            Each entry stores the index plus the base of the sequence that wrote it. Starting a new
+ *            sequence moves the base past the last one, so every older entry reads as empty without
+ *            touching the table. The table is only cleared when the base would pass the uint32_t limit.
+ * 
+ * Academic use: Affero General Public License version 1.
+ *
+ * Any restrictions to use for-profit or non-academics: Alternative commercial license is needed.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * 
+ * Please contact Dr. Hani Z. Girgis (hzgirgis@buffalo.edu) if you need more information.
+ * 
+ * Copyright (C) 2022 by the authors.
+ */
+
+#pragma once
+
+#include "LtrParameters.h"
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include <assert.h>
+
+class LastIndexTable
+{
+private:
+    // Variables
+    int k;
+
+    // 0 is empty; otherwise the index plus the base at the time it was written
+    std::vector<uint32_t> table;
+    uint32_t base;
+    uint32_t length;
+
+    // Methods
+    static std::unique_ptr<LastIndexTable> &getThreadTable();
+
+public:
+    
+    // Constructor
+    LastIndexTable(int _k);
+
+    LastIndexTable(const LastIndexTable &) = delete;
+    LastIndexTable &operator=(const LastIndexTable &) = delete;
+
+    /**
+     * The calling thread's table for k-mers of length k. It is allocated on the first call
+     * and kept until the thread ends, so it must not be used by two scorers at once.
+     */
+    static LastIndexTable &forThread(int k);
+
+    // Frees the calling thread's table
+    static void releaseThreadTable();
+
+    // Getter and Setters
+    int getK() const;
+
+    // Methods
+
+    // Forgets every index; a sequence of this length is scored next
+    void reset(int _length);
+
+    // LtrParameters::INITIAL_VALUE if the k-mer was not seen since the last reset
+    inline int get(int hash) const {
+        uint32_t value = table[hash];
+        return value >= base ? static_cast<int>(value - base) : LtrParameters::INITIAL_VALUE;
+    }
+
+    inline void set(int hash, int index) {
+        assert(index >= 0 && static_cast<uint32_t>(index) < length);
+        table[hash] = base + index;
+    }
+};
+
+/**
+ * The same lookups for a short sequence: an open-addressing table sized to the sequence
+ * instead of all 4^k k-mers, so it stays in cache and needs no thread table.
+ */
+class SparseLastIndexTable
+{
+private:
+    // Variables
+    // (k-mer hash, last index); a hash of -1 is an empty slot
+    std::vector<std::pair<int, int>> slotVec;
+    uint32_t mask;
+
+    inline uint32_t findSlot(int hash) const {
+        // Fibonacci hashing spreads k-mers that differ only in their last bases
+        uint32_t slot = (static_cast<uint32_t>(hash) * 2654435761u) & mask;
+        while (slotVec[slot].first != hash && slotVec[slot].first != -1) {
+            slot = (slot + 1) & mask;
+        }
+        return slot;
+    }
+
+public:
+    
+    // Constructor
+
+    // Holds up to length k-mers at most half full
+    SparseLastIndexTable(int length);
+
+    // Methods
+    inline int get(int hash) const {
+        auto &slot = slotVec[findSlot(hash)];
+        return slot.first == hash ? slot.second : LtrParameters::INITIAL_VALUE;
+    }
+
+    inline void set(int hash, int index) {
+        assert(hash >= 0);
+        slotVec[findSlot(hash)] = {hash, index};
+    }
+};
@@ -0,0 +1,88 @@
+/*
+ * LtrDetector v2.0 annotates LTR retro-transposons in a genome.
+ * 
+ * LtrAnnotator
+ * 
+ *  Created on: Oct 17, 2026
+ * Reviewer:
+ *   Purpose: Runs the look4ltrs pipeline on a sequence held in memory.
+ * 
+ * Academic use: Affero General Public License version 1.
+ *
+ * Any restrictions to use for-profit or non-academics: Alternative commercial license is needed.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * 
+ * Please contact Dr. Hani Z. Girgis (hzgirgis@buffalo.edu) if you need more information.
+ * 
+ * Copyright (C) 2022 by the authors.
+ */
+
+#include "LtrAnnotator.h"
+#include "LtrParameters.h"
+
+LtrAnnotation::LtrAnnotation(std::vector<RT*> _rtVec, std::vector<RT*> _complexVec) : rtVec(_rtVec), complexVec(_complexVec)
+{
+
+}
+
+LtrAnnotation::~LtrAnnotation() {
+    for (auto rt : rtVec) {
+        delete rt;
+    }
+    for (auto cpx : complexVec) {
+        delete cpx;
+    }
+}
+
+LtrAnnotation::LtrAnnotation(LtrAnnotation &&other) {
+    rtVec.swap(other.rtVec);
+    complexVec.swap(other.complexVec);
+}
+
+LtrAnnotation &LtrAnnotation::operator=(LtrAnnotation &&other) {
+    // The RTs held before are deleted along with other
+    rtVec.swap(other.rtVec);
+    complexVec.swap(other.complexVec);
+    return *this;
+}
+
+const std::vector<RT*> &LtrAnnotation::getRtVec() const {
+    return rtVec;
+}
+
+const std::vector<RT*> &LtrAnnotation::getComplexVec() const {
+    return complexVec;
+}
+
+LtrAnnotator::LtrAnnotator(Red &_red, IdentityCalculator<int32_t> &_icStandard, IdentityCalculator<int32_t> &_icRecent) :
+    red(_red), icStandard(_icStandard), icRecent(_icRecent)
+{
+
+}
+
+LtrAnnotation LtrAnnotator::annotate(const std::string &sequence) const {
+    // The modules take std::string* but never modify the sequence
+    std::string *seqPtr = const_cast<std::string*>(&sequence);
+
+    // Too short to hold an LTR RT; the scorers do not take sequences shorter than their k-mers
+    if (sequence.size() < LtrParameters::MIN_RT) {
+        return LtrAnnotation{{}, {}};
+    }
+
+    // The same steps look4ltrs runs on a chromosome
+    ModulePipeline mp{red};
+    mp.buildElements(seqPtr);
+    mp.matchElements(icStandard, icRecent, seqPtr);
+    mp.findRTs();
+    mp.findDeepNests(icStandard, icRecent, seqPtr);
+    mp.process(icStandard, seqPtr);
+    mp.filter(icStandard, seqPtr);
+
+    // The pipeline does not delete its RTs; the annotation takes them over
+    LtrAnnotation r{*mp.getRtVec(), *mp.getComplexVec()};
+    mp.getRtVec()->clear();
+    mp.getComplexVec()->clear();
+    return r;
+}
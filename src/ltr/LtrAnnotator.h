@@ -0,0 +1,92 @@
+/*
+ * LtrDetector v2.0 annotates LTR retro-transposons in a genome.
+ * 
+ * LtrAnnotator
+ * 
+ *  Created on: Oct 17, 2026
+ * Reviewer:
+ *   Purpose: Runs the look4ltrs pipeline on a sequence held in memory, for programs that embed it.
+ *            Red and Identity are trained beforehand and shared by every call; nothing is
+ *            written to disk and the LTR RTs are returned as objects.
+ * 
+ * Academic use: Affero General Public License version 1.
+ *
+ * Any restrictions to use for-profit or non-academics: Alternative commercial license is needed.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR Runs the look4ltrs pipeline on a sequence held in memory, for programs that embed it.
+ *            Red and Identity are trained beforehand and shared by every call; nothing is
+ *            written to disk and the LTR RTs are returned as objects..
+ * 
+ * Please contact Dr. Hani Z. Girgis (hzgirgis@buffalo.edu) if you need more information.
+ * 
+ * Copyright (C) 2022 by the authors.
+ */
+
+#pragma once
+
+#include "ModulePipeline.h"
+#include "RT.h"
+
+#include "../IdentityCalculator.h"
+#include "../red/Red.h"
+
+#include <string>
+#include <vector>
+#include <memory>
+
+/**
+ * The LTR RTs and the complex regions found in one sequence; owns them.
+ * Coordinates are 0-based positions in the sequence, ends exclusive, as in the BED and RTR files.
+ */
+class LtrAnnotation
+{
+private:
+    // Variables
+    std::vector<RT*> rtVec;
+    std::vector<RT*> complexVec;
+
+public:
+    // Constructor
+    LtrAnnotation(std::vector<RT*> _rtVec, std::vector<RT*> _complexVec);
+    ~LtrAnnotation();
+
+    LtrAnnotation(const LtrAnnotation &) = delete;
+    LtrAnnotation &operator=(const LtrAnnotation &) = delete;
+    LtrAnnotation(LtrAnnotation &&other);
+    LtrAnnotation &operator=(LtrAnnotation &&other);
+
+    // Getter and Setters
+
+    // LTR RTs and solo LTRs sorted by start; the nesting links point into this vector
+    const std::vector<RT*> &getRtVec() const;
+    const std::vector<RT*> &getComplexVec() const;
+};
+
+class LtrAnnotator
+{
+private:
+    // Variables
+    Red &red;
+    IdentityCalculator<int32_t> &icStandard;
+    IdentityCalculator<int32_t> &icRecent;
+
+public:
+    // Constructor
+
+    /**
+     * The models must outlive the annotator. Red may be loaded with Red::fromModel and the
+     * calculators with LtrUtility::loadCalculator from the files a look4ltrs run saves.
+     */
+    LtrAnnotator(Red &_red, IdentityCalculator<int32_t> &_icStandard, IdentityCalculator<int32_t> &_icRecent);
+
+    // Methods
+
+    /**
+     * Finds the LTR RTs of the sequence. The sequence must be upper case with N for unknown
+     * bases, as FastaReader gives it; it is read in place, not copied.
+     * Several threads may annotate at once, as look4ltrs does with its chromosomes.
+     * A sequence shorter than the shortest LTR RT gives an empty annotation.
+     */
+    LtrAnnotation annotate(const std::string &sequence) const;
+};
@@ -373,3 +373,21 @@ static std::unique_ptr<IdentityCalculator<int32_t>> LtrUtility::buildCalculator(
     std::unique_ptr<IdentityCalculator<int32_t>> ic = std::make_unique<IdentityCalculator<int32_t>>(&dg, coreCount, threshold, skip, true);
     return ic;
 }
+
+std::unique_ptr<IdentityCalculator<int32_t>> LtrUtility::buildCalculator(double threshold, const ElementDB &db, int coreCount, bool skip, std::string modelFile) {
+    SynDataGenerator dg{db.makeBlock(), threshold, coreCount};
+    int64_t maxLength = dg.getMaxLength();
+    assert (maxLength <= std::numeric_limits<int32_t>::max());
+
+    std::unique_ptr<IdentityCalculator<int32_t>> ic = std::make_unique<IdentityCalculator<int32_t>>(&dg, coreCount, threshold, skip, true, modelFile);
+    return ic;
+}
+
+std::unique_ptr<IdentityCalculator<int32_t>> LtrUtility::loadCalculator(double threshold, std::string modelFile, bool skip) {
+    Serializer serializer{modelFile};
+    int64_t maxLength = serializer.getMaxLength();
+    assert (maxLength <= std::numeric_limits<int32_t>::max());
+
+    std::unique_ptr<IdentityCalculator<int32_t>> ic = std::make_unique<IdentityCalculator<int32_t>>(serializer, threshold, skip, true);
+    return ic;
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "RT.h"
+#include "ElementDB.h"
 
 #include "../IdentityCalculator.h"
 #include "../SynDataGenerator.h"
@@ -86,6 +87,16 @@ public:
 
     static std::unique_ptr<IdentityCalculator<int32_t>> buildCalculator(double threshold, std::string dbPath, int coreCount, bool skip);
 
+    /**
+     * Trains a calculator on the element database; if modelFile is given, the model is also written there
+     */
+    static std::unique_ptr<IdentityCalculator<int32_t>> buildCalculator(double threshold, const ElementDB &db, int coreCount, bool skip, std::string modelFile = "");
+
+    /**
+     * Builds a calculator from a model written by buildCalculator; nothing is trained
+     */
+    static std::unique_ptr<IdentityCalculator<int32_t>> loadCalculator(double threshold, std::string modelFile, bool skip);
+
 
 
 private:
@@ -19,8 +19,8 @@
  */
 #include "Matcher.h"
 
-Matcher::Matcher(std::vector<Element> &_fElementVec, std::vector<Element> &_bElementVec, Red &_red, IdentityCalculator<int32_t> &_ic, IdentityCalculator<int32_t> &_icRecent,  const std::string *_seq)
-    : fElementVec(_fElementVec), bElementVec(_bElementVec), red(_red), ic(_ic), icRecent(_icRecent), seq(_seq){
+Matcher::Matcher(std::vector<Element> &_fElementVec, std::vector<Element> &_bElementVec, const RedScoreTrack &_redTrack, IdentityCalculator<int32_t> &_ic, IdentityCalculator<int32_t> &_icRecent,  const std::string *_seq)
+    : fElementVec(_fElementVec), bElementVec(_bElementVec), redTrack(_redTrack), ic(_ic), icRecent(_icRecent), seq(_seq){
 
     checkValid();
 
@@ -683,8 +683,8 @@ void Matcher::runCases()
         // std::vector<CaseMatcher *> caseVec{new CaseSingle{ic, red, seq}, new CaseRecent{ic, red, seq}, 
         //                                     new CaseSequential{ic, red, seq}, new CaseSolo{ic, red, seq}};
 
-        std::vector<CaseMatcher *> caseVec{new CaseSolo{ic, icRecent, red, seq}, new CaseSingle{ic, icRecent, red, seq}, new CaseRecent{ic, icRecent,red, seq}};
-        CaseRecentComplex * complex = new CaseRecentComplex{ic, icRecent, red, seq};
+        std::vector<CaseMatcher *> caseVec{new CaseSolo{ic, icRecent, redTrack, seq}, new CaseSingle{ic, icRecent, redTrack, seq}, new CaseRecent{ic, icRecent, redTrack, seq}};
+        CaseRecentComplex * complex = new CaseRecentComplex{ic, icRecent, redTrack, seq};
                                             
         auto [forward, backward] = retrieveForwardBackward(subGraph);
         assert(!forward.empty() || !backward.empty());
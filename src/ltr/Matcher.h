@@ -36,7 +36,7 @@
 #include "CaseRecentComplex.h"
 
 #include "../IdentityCalculator.h"
-#include "../red/Red.h"
+#include "../red/RedScoreTrack.h"
 #include "../utility/LocAlign.h"
 
 #include <vector>
@@ -71,7 +71,7 @@ private:
     std::vector<Element> &fElementVec;
     std::vector<Element> &bElementVec;
 
-    Red &red;
+    const RedScoreTrack &redTrack;
     IdentityCalculator<int32_t> &ic;
     IdentityCalculator<int32_t> &icRecent;
 
@@ -155,7 +155,7 @@ public:
      * Constructor
      * 
      */
-    Matcher(std::vector<Element> &_fElementVec, std::vector<Element> &_bElementVec, Red &_red, 
+    Matcher(std::vector<Element> &_fElementVec, std::vector<Element> &_bElementVec, const RedScoreTrack &_redTrack, 
             IdentityCalculator<int32_t> &_ic, IdentityCalculator<int32_t> &_icRecent, const std::string *_seq);
 
     // Destructor; destroys the RTs in the RtVec
@@ -0,0 +1,55 @@
+/*
+ * LtrDetector v2.0 annotates LTR retro-transposons in a genome.
+ * 
+ * MemoryBudget
+ * 
+ *  Created on: Oct 17, 2026
+ * Reviewer:
+ *   Purpose: Admits chromosome tasks only while their estimated memory fits in a budget.
+ * 
+ * Academic use: Affero General Public License version 1.
+ *
+ * Any restrictions to use for-profit or non-academics: Alternative commercial license is needed.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * 
+ * Please contact Dr. Hani Z. Girgis (hzgirgis@buffalo.edu) if you need more information.
+ * 
+ * Copyright (C) 2022 by the authors.
+ */
+
+#include "MemoryBudget.h"
+
+MemoryBudget::MemoryBudget(long long _budget) : budget(_budget), inUse(0), running(0)
+{
+
+}
+
+long long MemoryBudget::getBudget() const {
+    return budget;
+}
+
+bool MemoryBudget::isLimited() const {
+    return budget >= 0;
+}
+
+void MemoryBudget::acquire(long long bytes) {
+    assert(bytes >= 0);
+    std::unique_lock<std::mutex> lock(mtx);
+    cv.wait(lock, [this, bytes]() {
+        return !isLimited() || running == 0 || inUse + bytes <= budget;
+    });
+    inUse += bytes;
+    running++;
+}
+
+void MemoryBudget::release(long long bytes) {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        inUse -= bytes;
+        running--;
+        assert(inUse >= 0 && running >= 0);
+    }
+    cv.notify_all();
+}
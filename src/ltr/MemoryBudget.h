@@ -0,0 +1,55 @@
+/*
+ * LtrDetector v2.0 annotates LTR retro-transposons in a genome.
+ * 
+ * MemoryBudget
+ * 
+ *  Created on: Oct 17, 2026
+ * Reviewer:
+ *   Purpose: Admits chromosome tasks only while their estimated memory fits in a budget.
+ *            A thread whose task does not fit waits until other tasks release their memory.
+ *            A task that is larger than the whole budget still runs, but alone.
+ * 
+ * Academic use: Affero General Public License version 1.
+ *
+ * Any restrictions to use for-profit or non-academics: Alternative commercial license is needed.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * 
+ * Please contact Dr. Hani Z. Girgis (hzgirgis@buffalo.edu) if you need more information.
+ * 
+ * Copyright (C) 2022 by the authors.
+ */
+
+#pragma once
+
+#include <mutex>
+#include <condition_variable>
+#include <assert.h>
+
+class MemoryBudget
+{
+private:
+    // Variables
+    // In bytes; a negative budget means there is no limit
+    long long budget;
+    long long inUse;
+    int running;
+
+    std::mutex mtx;
+    std::condition_variable cv;
+
+public:
+    
+    // Constructor
+    MemoryBudget(long long _budget = -1);
+
+    // Getter and Setters
+    long long getBudget() const;
+    bool isLimited() const;
+
+    // Methods
+    // Blocks until the bytes fit in the budget, or until no other task is running
+    void acquire(long long bytes);
+    void release(long long bytes);
+};
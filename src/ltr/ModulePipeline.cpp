@@ -25,12 +25,123 @@
 
 #include "ModulePipeline.h"
 
+namespace {
+
+// Windows report the same RT at a seam if both of its LTRs overlap each other by at least this much; same as removeDuplicateRTs
+const double SEAM_OVERLAP = 0.5;
+
+// LTR RTs linked by nesting; they are kept or dropped together
+struct NestTree
+{
+    int windowIndex;
+    int start;
+    int end;
+    RT *outer;
+    std::vector<RT*> rtVec;
+    bool isDropped;
+};
+
+std::vector<NestTree> findNestTrees(std::vector<RT*> &rtVec, int windowIndex) {
+    std::unordered_map<RT*, int> indexTable;
+    for (int i = 0; i < rtVec.size(); i++) {
+        indexTable[rtVec[i]] = i;
+    }
+
+    std::vector<int> parentVec(rtVec.size());
+    std::iota(parentVec.begin(), parentVec.end(), 0);
+    std::function<int(int)> findRoot = [&](int i) {
+        return parentVec[i] == i ? i : parentVec[i] = findRoot(parentVec[i]);
+    };
+    for (int i = 0; i < rtVec.size(); i++) {
+        for (auto outer : rtVec[i]->getOuterSet()) {
+            auto itr = indexTable.find(outer);
+            if (itr != indexTable.end()) {
+                parentVec[findRoot(i)] = findRoot(itr->second);
+            }
+        }
+    }
+
+    // Trees are listed in the order of their first RT, so the result does not depend on pointer values
+    std::vector<NestTree> r;
+    std::unordered_map<int, int> treeTable;
+    for (int i = 0; i < rtVec.size(); i++) {
+        int root = findRoot(i);
+        if (treeTable.count(root) == 0) {
+            treeTable[root] = r.size();
+            r.push_back(NestTree{windowIndex, rtVec[i]->getStart(), rtVec[i]->getEnd(), rtVec[i], {}, false});
+        }
+        NestTree &tree = r.at(treeTable[root]);
+        tree.rtVec.push_back(rtVec[i]);
+        tree.start = std::min(tree.start, rtVec[i]->getStart());
+        tree.end = std::max(tree.end, rtVec[i]->getEnd());
+        if (rtVec[i]->getSize() > tree.outer->getSize()) {
+            tree.outer = rtVec[i];
+        }
+    }
+    return r;
+}
+
+// Unlinks the RTs of the tree from each other before deleting them, so no destructor reaches a deleted RT
+void deleteNestTree(NestTree &tree) {
+    std::unordered_set<RT*> treeSet(tree.rtVec.begin(), tree.rtVec.end());
+    for (auto rt : tree.rtVec) {
+        if (rt->hasRightLTR()) {
+            for (auto nest : rt->getNestSet()) {
+                if (treeSet.count(nest) == 1) {
+                    rt->removeNest(nest);
+                    nest->removeOuter(rt);
+                }
+            }
+        }
+    }
+    for (auto rt : tree.rtVec) {
+        delete rt;
+    }
+    tree.rtVec.clear();
+}
+
+bool isMutualOverlap(int start1, int end1, int start2, int end2) {
+    int overlap = std::min(end1, end2) - std::max(start1, start2);
+    return LtrUtility::isGreaterEqual(double(overlap) / (end1 - start1), SEAM_OVERLAP) && LtrUtility::isGreaterEqual(double(overlap) / (end2 - start2), SEAM_OVERLAP);
+}
+
+bool isMutualOverlap(const Element *e1, const Element *e2) {
+    return isMutualOverlap(e1->getStart(), e1->getEnd(), e2->getStart(), e2->getEnd());
+}
+
+bool isSameRT(RT *r1, RT *r2) {
+    if (r1->hasRightLTR() != r2->hasRightLTR()) {
+        return false;
+    }
+    bool isSame = isMutualOverlap(r1->getLeftLTR(), r2->getLeftLTR());
+    if (r1->hasRightLTR()) {
+        isSame = isSame && isMutualOverlap(r1->getRightLTR(), r2->getRightLTR());
+    }
+    return isSame;
+}
+
+}
+
 ModulePipeline::ModulePipeline(Red &_red) : red(_red)
 {
     mat = nullptr;
     forwardMerger = nullptr;
     backwardMerger = nullptr;
     dp = nullptr;
+    store = nullptr;
+    window = GenomeStore::Window{-1, 0, 0, 0, 0};
+    packedChromosome = nullptr;
+    packedFrom = nullptr;
+    redTrack = nullptr;
+    redTrackFrom = nullptr;
+}
+
+ModulePipeline::ModulePipeline(Red &_red, const GenomeStore &_store, const GenomeStore::Window &_window) : ModulePipeline(_red)
+{
+    assert(_window.chromID >= 0 && _window.chromID < _store.getChromCount());
+    assert(_window.offset >= 0 && _window.offset + _window.length <= _store.getSize(_window.chromID));
+    store = &_store;
+    window = _window;
 }
 
 ModulePipeline::~ModulePipeline()
@@ -61,13 +172,42 @@ ModulePipeline::~ModulePipeline()
         delete dp;
         dp = nullptr;
     }
+    releasePackedChromosome();
+    releaseRedTrack();
+}
+
+long long ModulePipeline::estimateBuildMemory(long long length) {
+    // ScorerTr: the packed chromosome (2 bits and an unknown bit per base) and the two score
+    // tracks. A track keeps a run per stretch of equal scores, so only repeats cost memory; both
+    // are budgeted together at an int per base, i.e., a run every 6 bases of each strand.
+    // The thread's last-index table outlives the task and is counted as resident by the caller.
+    long long packed = length / 4 + length / 8;
+    long long scorer = packed + length * sizeof(int);
+
+    // Detector: Red's score track of the chromosome is kept while Red predicts the repeats.
+    // The prediction scans the three strands at once; each scan copies the sequence, scores it,
+    // and decodes it with the HMM; the decoder keeps two back pointer bits and a path bit per base.
+    long long redScore = length * sizeof(int);
+    long long redScan = 3 * (2 * length + length * sizeof(int) + length / 4 + length / 8);
+    long long detector = redScore + redScan;
+
+    return std::max(scorer, detector);
+}
+
+long long ModulePipeline::estimateSearchMemory(long long length) {
+    // Red's score track of the chromosome, which the cases and the filter query, the copy of the
+    // digits and the scores Red makes while building it, and the packed chromosome the identity
+    // scores of the LTRs are read from. Deep nests are rescored with the thread's last-index
+    // table, which outlives the task and is counted as resident by the caller.
+    long long redTrack = length * sizeof(int) + length + length * sizeof(int);
+    return redTrack + length / 4 + length / 8;
 }
 
 void ModulePipeline::buildStretches(std::string *chromosome)
 { 
     // Score the sequence
     // std::cout << "Scoring the sequence..." << std::endl;
-    ScorerTr *st = new ScorerTr(*chromosome, LtrParameters::K, LtrParameters::MIN_DISTANCE, LtrParameters::MAX_DISTANCE);
+    ScorerTr *st = new ScorerTr(getPackedChromosome(chromosome), LtrParameters::K, LtrParameters::MIN_DISTANCE, LtrParameters::MAX_DISTANCE);
 
     // Merge the scores
     // std::cout << "Merging the scores forward..." << std::endl;
@@ -90,7 +230,7 @@ void ModulePipeline::buildElements(std::string *chromosome)
 
     // Detect the elements
     // std::cout << "Detecting the elements..." << std::endl;
-    Detector dt{red, *chromosome};
+    Detector dt{red, *chromosome, getRedTrack(chromosome)};
     fElement = dt.apply(*forwardMerger->getStretchVec());
     bElement = dt.apply(*backwardMerger->getStretchVec());
     // std::cout << "Done detecting the elements." << std::endl;
@@ -155,6 +295,16 @@ void ModulePipeline::writeToDB(std::string filePath, int fastaID, std::string ch
     writeToDBHelper(filePath, bElement, fastaID, chromName, chromosome);
 }
 
+void ModulePipeline::addToDBHelper(ElementDB &db, std::vector<Element> & eleVec) {
+    for (auto &ele : eleVec) {
+        // An element in the overlap of two windows is added by the window whose core holds its center
+        int center = window.offset + ele.getStart() + ele.getSize() / 2;
+        if (ele.getSize() >= LtrParameters::MIN_LTR && center >= window.coreStart && center < window.coreEnd) {
+            db.add(window.chromID, window.offset + ele.getStart(), window.offset + ele.getEnd());
+        }
+    }
+}
+
 void ModulePipeline::writeElementsHelper(std::string filePath, std::vector<Element> & eleVec) {
     std::ofstream eleFile{filePath};
     for (auto &ele : eleVec) {
@@ -257,7 +407,7 @@ void ModulePipeline::removeElements() {
 
 void ModulePipeline::matchElements(IdentityCalculator<int32_t> &icStandard, IdentityCalculator<int32_t> &icRecent, std::string *chromosome ) {
 
-    mat = new Matcher{fElement, bElement, red, icStandard, icRecent, chromosome};
+    mat = new Matcher{fElement, bElement, getRedTrack(chromosome), icStandard, icRecent, chromosome};
 }
 
 void ModulePipeline::findRTs() {
@@ -292,13 +442,276 @@ void ModulePipeline::process(IdentityCalculator<int32_t> &icStandard, std::strin
 }
 
 void ModulePipeline::filter(IdentityCalculator<int32_t> &icStandard, std::string *chromosome) {
-    Filter filter(*mat->getRtVec(), red, chromosome);
+    Filter filter(*mat->getRtVec(), getRedTrack(chromosome), chromosome);
     filter.apply();
+    const utility::PackedSequence &packed = getPackedChromosome(chromosome);
     for (auto rt : *mat->getRtVec()) {
         if (rt->hasRightLTR()) {
-            std::string leftLTR = chromosome->substr(rt->getLeftLTR()->getStart(), rt->getLeftLTR()->getSize());
-            std::string rightLTR = chromosome->substr(rt->getRightLTR()->getStart(), rt->getRightLTR()->getSize());
-            rt->setIdentityScore(icStandard.score(&leftLTR, &rightLTR));
+            const Element *left = rt->getLeftLTR();
+            const Element *right = rt->getRightLTR();
+            rt->setIdentityScore(icStandard.score(&packed, left->getStart(), left->getEnd(), &packed, right->getStart(), right->getEnd()));
+        }
+    }
+}
+
+std::string *ModulePipeline::getChromosome() {
+    assert(store != nullptr);
+    if (isWholeChromosome()) {
+        return store->getSequence(window.chromID);
+    }
+    if (windowSeq.empty()) {
+        windowSeq = store->getSequence(window.chromID)->substr(window.offset, window.length);
+    }
+    return &windowSeq;
+}
+
+bool ModulePipeline::isWholeChromosome() const {
+    return window.offset == 0 && window.length == store->getSize(window.chromID);
+}
+
+void ModulePipeline::releaseWindow() {
+    std::string().swap(windowSeq);
+    releasePackedChromosome();
+    releaseRedTrack();
+}
+
+const utility::PackedSequence &ModulePipeline::getPackedChromosome(std::string *chromosome) {
+    if (packedChromosome == nullptr || packedFrom != chromosome || packedChromosome->size() != chromosome->size()) {
+        releasePackedChromosome();
+        packedChromosome = new utility::PackedSequence(*chromosome);
+        packedFrom = chromosome;
+    }
+    return *packedChromosome;
+}
+
+void ModulePipeline::releasePackedChromosome() {
+    if (packedChromosome != nullptr) {
+        delete packedChromosome;
+        packedChromosome = nullptr;
+    }
+    packedFrom = nullptr;
+}
+
+const RedScoreTrack &ModulePipeline::getRedTrack(std::string *chromosome) {
+    if (redTrack == nullptr || redTrackFrom != chromosome || redTrack->getLength() != chromosome->size()) {
+        releaseRedTrack();
+        redTrack = new RedScoreTrack(red.scoreTrack(*chromosome));
+        redTrackFrom = chromosome;
+    }
+    return *redTrack;
+}
+
+void ModulePipeline::releaseRedTrack() {
+    if (redTrack != nullptr) {
+        delete redTrack;
+        redTrack = nullptr;
+    }
+    redTrackFrom = nullptr;
+}
+
+void ModulePipeline::buildElements() {
+    buildElements(getChromosome());
+    releaseWindow();
+}
+
+void ModulePipeline::addToDB(ElementDB &db) {
+    assert(store != nullptr);
+    addToDBHelper(db, fElement);
+    addToDBHelper(db, bElement);
+}
+
+void ModulePipeline::saveElements(std::string filePath) {
+    std::ofstream out{filePath, std::ios::binary};
+    Checkpoint::writeElements(out, fElement);
+    Checkpoint::writeElements(out, bElement);
+}
+
+bool ModulePipeline::loadElements(std::string filePath) {
+    std::ifstream in{filePath, std::ios::binary};
+    try {
+        // The stretches of a damaged file stay in heapStretchVec until the pipeline is deleted
+        auto forwardVec = Checkpoint::readElements(in, heapStretchVec);
+        auto backwardVec = Checkpoint::readElements(in, heapStretchVec);
+        fElement = std::move(forwardVec);
+        bElement = std::move(backwardVec);
+    }
+    catch (const CorruptCheckpointException &e) {
+        return false;
+    }
+    return true;
+}
+
+void ModulePipeline::saveRTs(std::string filePath) {
+    std::ofstream out{filePath, std::ios::binary};
+    Checkpoint::writeRTs(out, *getRtVec(), *getComplexVec());
+}
+
+bool ModulePipeline::loadRTs(std::string filePath) {
+    std::ifstream in{filePath, std::ios::binary};
+    try {
+        Checkpoint::readRTs(in, loadedRtVec, loadedComplexVec);
+    }
+    catch (const CorruptCheckpointException &e) {
+        return false;
+    }
+    return true;
+}
+
+void ModulePipeline::matchElements(IdentityCalculator<int32_t> &icStandard, IdentityCalculator<int32_t> &icRecent) {
+    matchElements(icStandard, icRecent, getChromosome());
+}
+
+void ModulePipeline::findDeepNests(IdentityCalculator<int32_t> &icStandard, IdentityCalculator<int32_t> &icRecent) {
+    findDeepNests(icStandard, icRecent, getChromosome());
+}
+
+void ModulePipeline::process(IdentityCalculator<int32_t> &icStandard, bool nestOnly) {
+    process(icStandard, getChromosome(), nestOnly);
+}
+
+void ModulePipeline::filter(IdentityCalculator<int32_t> &icStandard) {
+    filter(icStandard, getChromosome());
+    releaseWindow();
+    if (!isWholeChromosome()) {
+        keepCore();
+    }
+}
+
+void ModulePipeline::keepCore() {
+    auto rtVecPtr = getRtVec();
+    std::vector<RT*> keptVec;
+    for (auto &tree : findNestTrees(*rtVecPtr, 0)) {
+        int center = window.offset + tree.start + (tree.end - tree.start) / 2;
+        if (center >= window.coreStart && center < window.coreEnd) {
+            keptVec.insert(keptVec.end(), tree.rtVec.begin(), tree.rtVec.end());
+        }
+        else {
+            deleteNestTree(tree);
+        }
+    }
+    LtrUtility::sortRTs(keptVec);
+    *rtVecPtr = keptVec;
+
+    auto complexVecPtr = getComplexVec();
+    for (auto &cpx : *complexVecPtr) {
+        int center = window.offset + cpx->getStart() + cpx->getSize() / 2;
+        if (center < window.coreStart || center >= window.coreEnd) {
+            delete cpx;
+            cpx = nullptr;
+        }
+    }
+    complexVecPtr->erase(std::remove(complexVecPtr->begin(), complexVecPtr->end(), nullptr), complexVecPtr->end());
+}
+
+void ModulePipeline::shiftToChromosome() {
+    for (auto rt : *getRtVec()) {
+        rt->push(window.offset);
+        // push only moves the LTRs; the PPT and the TSD are moved here if they were found
+        if (rt->hasRightLTR()) {
+            int PPTStart = rt->getPPTStart();
+            int PPTEnd = rt->getPPTEnd();
+            if (PPTStart >= 0) {
+                PPTStart += window.offset;
+                PPTEnd += window.offset;
+            }
+            std::pair<int, int> leftTSD = rt->getLeftTSD();
+            std::pair<int, int> rightTSD = rt->getRightTSD();
+            if (rt->getIsTSDExist()) {
+                leftTSD = {leftTSD.first + window.offset, leftTSD.second + window.offset};
+                rightTSD = {rightTSD.first + window.offset, rightTSD.second + window.offset};
+            }
+            static_cast<RTComplete*>(rt)->restore(PPTStart, PPTEnd, rt->getIsTSDExist(), leftTSD, rightTSD);
+        }
+    }
+    for (auto cpx : *getComplexVec()) {
+        cpx->push(window.offset);
+    }
+}
+
+void ModulePipeline::stitch(std::vector<ModulePipeline*> &windowVec, std::vector<RT*> &rtVec, std::vector<RT*> &complexVec) {
+    std::vector<NestTree> treeVec;
+    std::vector<std::pair<RT*, int>> cpxVec;
+
+    // Graph groups are numbered per window; later windows continue after the groups of earlier ones
+    int groupOffset = 0;
+    for (int w = 0; w < windowVec.size(); w++) {
+        ModulePipeline &mp = *windowVec.at(w);
+        mp.shiftToChromosome();
+
+        int maxGroup = -1;
+        for (auto rtVecPtr : {mp.getRtVec(), mp.getComplexVec()}) {
+            for (auto rt : *rtVecPtr) {
+                if (rt->getGraphGroup() >= 0) {
+                    maxGroup = std::max(maxGroup, rt->getGraphGroup());
+                    rt->setGraphGroup(rt->getGraphGroup() + groupOffset);
+                }
+            }
+        }
+        groupOffset += maxGroup + 1;
+
+        auto windowTreeVec = findNestTrees(*mp.getRtVec(), w);
+        treeVec.insert(treeVec.end(), windowTreeVec.begin(), windowTreeVec.end());
+        for (auto cpx : *mp.getComplexVec()) {
+            cpxVec.push_back({cpx, w});
+        }
+
+        mp.getRtVec()->clear();
+        mp.getComplexVec()->clear();
+    }
+
+    // Two windows may still both report an RT whose ends differ slightly, putting their centers on either side of the seam.
+    // The higher ranked case is kept; on a tie, the one from the earlier window.
+    std::stable_sort(treeVec.begin(), treeVec.end(), [](const NestTree &t1, const NestTree &t2)
+    {
+        return t1.start < t2.start;
+    });
+    for (int i = 0; i < treeVec.size(); i++) {
+        for (int j = i + 1; j < treeVec.size() && treeVec[j].start < treeVec[i].end && !treeVec[i].isDropped; j++) {
+            NestTree &t1 = treeVec[i];
+            NestTree &t2 = treeVec[j];
+            if (t2.isDropped || t1.windowIndex == t2.windowIndex || !isSameRT(t1.outer, t2.outer)) {
+                continue;
+            }
+            int rank1 = t1.outer->getCaseRank();
+            int rank2 = t2.outer->getCaseRank();
+            bool isFirstKept = rank1 != rank2 ? rank1 > rank2 : t1.windowIndex < t2.windowIndex;
+            (isFirstKept ? t2 : t1).isDropped = true;
+        }
+    }
+    for (auto &tree : treeVec) {
+        if (tree.isDropped) {
+            deleteNestTree(tree);
+        }
+        else {
+            rtVec.insert(rtVec.end(), tree.rtVec.begin(), tree.rtVec.end());
+        }
+    }
+    LtrUtility::sortRTs(rtVec);
+
+    // Complex regions reported by two windows are kept once, from the earlier window
+    std::stable_sort(cpxVec.begin(), cpxVec.end(), [](const std::pair<RT*, int> &c1, const std::pair<RT*, int> &c2)
+    {
+        return c1.first->getStart() < c2.first->getStart();
+    });
+    std::vector<bool> isDroppedVec(cpxVec.size(), false);
+    for (int i = 0; i < cpxVec.size(); i++) {
+        if (isDroppedVec[i]) {
+            continue;
+        }
+        RT *cpx = cpxVec[i].first;
+        for (int j = i + 1; j < cpxVec.size() && cpxVec[j].first->getStart() < cpx->getEnd(); j++) {
+            RT *next = cpxVec[j].first;
+            if (!isDroppedVec[j] && cpxVec[j].second != cpxVec[i].second && isMutualOverlap(cpx->getStart(), cpx->getEnd(), next->getStart(), next->getEnd())) {
+                isDroppedVec[j] = true;
+            }
+        }
+    }
+    for (int i = 0; i < cpxVec.size(); i++) {
+        if (isDroppedVec[i]) {
+            delete cpxVec[i].first;
+        }
+        else {
+            complexVec.push_back(cpxVec[i].first);
         }
     }
 }
@@ -312,11 +725,11 @@ DirectedGraph<Element>* ModulePipeline::getGraph() const {
 }
 
 std::vector<RT*>* ModulePipeline::getRtVec() {
-    return mat->getRtVec();
+    return mat != nullptr ? mat->getRtVec() : &loadedRtVec;
 }
 
 std::vector<RT*>* ModulePipeline::getComplexVec() {
-    return mat->getComplexVec();
+    return mat != nullptr ? mat->getComplexVec() : &loadedComplexVec;
 }
 
 std::pair<int, int> ModulePipeline::getFamilyRegion(RT* rt) {
@@ -38,13 +38,22 @@
 #include "RT.h"
 #include "DirectedGraph.h"
 #include "DeepNesting.h"
+#include "GenomeStore.h"
+#include "ElementDB.h"
+#include "Checkpoint.h"
 
 #include "../red/Red.h"
 
 
 #include <string>
+#include <vector>
 #include <filesystem>
 #include <iostream>
+#include <algorithm>
+#include <numeric>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
 
 
 class ModulePipeline
@@ -67,9 +76,44 @@ private:
 
     DeepNesting *dp;
 
+    // LTR RTs read from a checkpoint; used instead of the matcher's
+    std::vector<RT*> loadedRtVec;
+    std::vector<RT*> loadedComplexVec;
+
+    // The chromosome window this pipeline works on; only set if built from a genome store
+    const GenomeStore *store;
+    GenomeStore::Window window;
+
+    // Copy of the window's bases if it does not cover the whole chromosome; freed after each phase
+    std::string windowSeq;
+
+    // The chromosome packed for the k-mer scorers, and the sequence it was packed from; freed with the window
+    utility::PackedSequence *packedChromosome;
+    std::string *packedFrom;
+
+    // Red's scores of the chromosome, and the sequence they were scored from; freed with the window
+    RedScoreTrack *redTrack;
+    std::string *redTrackFrom;
+
     // Methods
+    std::string *getChromosome();
+    bool isWholeChromosome() const;
+    void releaseWindow();
+    const utility::PackedSequence &getPackedChromosome(std::string *chromosome);
+    void releasePackedChromosome();
+    const RedScoreTrack &getRedTrack(std::string *chromosome);
+    void releaseRedTrack();
+
+    // Keeps the LTR RTs whose nest tree is centered in the core of the window; coordinates are still window-relative
+    void keepCore();
+
+    // Moves the LTR RTs and complex regions from window to chromosome coordinates
+    void shiftToChromosome();
+
     void writeToDBHelper(std::string filePath, std::vector<Element> & eleVec, int fastaID, std::string chromName, std::string *chromosome);
 
+    void addToDBHelper(ElementDB &db, std::vector<Element> & eleVec);
+
     void writeElementsHelper(std::string filePath, std::vector<Element> & eleVec);
 
     std::vector<Element> readElementsHelper(std::string filePath);
@@ -79,6 +123,7 @@ public:
     // Constructor
 
     ModulePipeline(Red &_red);
+    ModulePipeline(Red &_red, const GenomeStore &_store, const GenomeStore::Window &_window);
     ~ModulePipeline();
 
     // Getter and Setters
@@ -89,6 +134,22 @@ public:
     std::pair<int, int> getFamilyRegion(RT* rt);
     DirectedGraph<Element>* getFamilyGraph(RT *rt);
 
+    /**
+     * Rough peak memory, in bytes, of buildElements and of the LTR RT search
+     * (matchElements through filter) on a chromosome of this length.
+     * Used to admit chromosome tasks under --max-memory.
+     */
+    static long long estimateBuildMemory(long long length);
+    static long long estimateSearchMemory(long long length);
+
+    /**
+     * Joins the LTR RTs and complex regions found in the windows of one chromosome,
+     * given in chromosome order, into rtVec and complexVec in chromosome coordinates.
+     * Each nest tree is reported by the window whose core holds its center; RTs that two
+     * windows still both report at a seam are kept once. The windows give up their RTs.
+     */
+    static void stitch(std::vector<ModulePipeline*> &windowVec, std::vector<RT*> &rtVec, std::vector<RT*> &complexVec);
+
     // Methods
     void buildStretches(std::string *chromosome);
     void buildElements(std::string *chromosome);
@@ -105,4 +166,18 @@ public:
     void findDeepNests(IdentityCalculator<int32_t> &icStandard, IdentityCalculator<int32_t> &icRecent, std::string *chromosome);
     void process(IdentityCalculator<int32_t> &icStandard, std::string *chromosome, bool nestOnly = false);
     void filter(IdentityCalculator<int32_t> &icStandard, std::string *chromosome);
+
+    // The same steps on the store chromosome given to the constructor
+    void buildElements();
+    void addToDB(ElementDB &db);
+
+    // Binary checkpoints of the elements and of the final LTR RTs; a load returns false if the file is damaged
+    void saveElements(std::string filePath);
+    bool loadElements(std::string filePath);
+    void saveRTs(std::string filePath);
+    bool loadRTs(std::string filePath);
+    void matchElements(IdentityCalculator<int32_t> &icStandard, IdentityCalculator<int32_t> &icRecent);
+    void findDeepNests(IdentityCalculator<int32_t> &icStandard, IdentityCalculator<int32_t> &icRecent);
+    void process(IdentityCalculator<int32_t> &icStandard, bool nestOnly = false);
+    void filter(IdentityCalculator<int32_t> &icStandard);
 };
\ No newline at end of file
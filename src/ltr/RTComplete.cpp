@@ -188,6 +188,16 @@ void RTComplete::setIdentityScore(double identityScore) {
     this->identityScore = identityScore;
 }
 
+void RTComplete::restore(int PPTStart, int PPTEnd, bool isTSDExist, std::pair<int, int> leftTSD, std::pair<int, int> rightTSD) {
+    this->PPTStart = PPTStart;
+    this->PPTEnd = PPTEnd;
+    this->isTSDExist = isTSDExist;
+    leftTSDStart = leftTSD.first;
+    leftTSDEnd = leftTSD.second;
+    rightTSDStart = rightTSD.first;
+    rightTSDEnd = rightTSD.second;
+}
+
 
 bool RTComplete::hasRightLTR() const
 {
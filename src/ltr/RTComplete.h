@@ -88,6 +88,9 @@ public:
     void setTSD(int leftStart, int leftEnd, int rightStart, int rightEnd);
     void setIdentityScore(double identityScore);
 
+    // Restores the PPT and the TSD read from a checkpoint; unlike setPPT and setTSD, nothing is checked and the LTRs are not moved
+    void restore(int PPTStart, int PPTEnd, bool isTSDExist, std::pair<int, int> leftTSD, std::pair<int, int> rightTSD);
+
 
     bool hasRightLTR() const;
     bool hasLeftLTR() const;
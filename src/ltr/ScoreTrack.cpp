@@ -0,0 +1,110 @@
+/*
+ * LtrDetector v2.0 annotates LTR retro-transposons in a genome.
+ * 
+ * ScoreTrack
+ * 
+ *  Created on: Oct 17, 2026
+ * Reviewer:
+ *   Purpose: The scores of one strand as runs of equal non-zero scores, and
+ *            count histograms of the scores of a stretch.
+ * 
+ * Academic use: Affero General Public License version 1.
+ *
+ * Any restrictions to use for-profit or non-academics: Alternative commercial license is needed.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * 
+ * Please contact Dr. Hani Z. Girgis (hzgirgis@buffalo.edu) if you need more information.
+ * 
+ * Copyright (C) 2022 by the authors.
+ */
+
+#include "ScoreTrack.h"
+
+ScoreTrack::ScoreTrack(int _length) : length(_length)
+{
+    assert(_length >= 0);
+}
+
+int ScoreTrack::getLength() const {
+    return length;
+}
+
+std::vector<ScoreRun> *ScoreTrack::getRuns() {
+    return &runVec;
+}
+
+std::vector<int> ScoreTrack::toVector() const {
+    std::vector<int> scoreVec(length, 0);
+    for (auto &run : runVec) {
+        std::fill(scoreVec.begin() + run.start, scoreVec.begin() + run.end, run.score);
+    }
+    return scoreVec;
+}
+
+bool ScoreTrack::operator==(const ScoreTrack &other) const {
+    return length == other.length && runVec == other.runVec;
+}
+
+ScoreHistogram::ScoreHistogram(const ScoreRun &run) : size(run.end - run.start)
+{
+    assert(run.score != 0);
+    assert(size > 0);
+    countVec.push_back(std::make_pair(run.score, size));
+    median = run.score;
+}
+
+int ScoreHistogram::getSize() const {
+    return size;
+}
+
+int ScoreHistogram::getMedian() const {
+    return median;
+}
+
+void ScoreHistogram::add(const ScoreHistogram &other) {
+    std::vector<std::pair<int, int>> sumVec;
+    sumVec.reserve(countVec.size() + other.countVec.size());
+
+    auto a = countVec.begin();
+    auto b = other.countVec.begin();
+    while (a != countVec.end() || b != other.countVec.end()) {
+        if (b == other.countVec.end() || (a != countVec.end() && a->first < b->first)) {
+            sumVec.push_back(*a++);
+        }
+        else if (a == countVec.end() || b->first < a->first) {
+            sumVec.push_back(*b++);
+        }
+        else {
+            sumVec.push_back(std::make_pair(a->first, a->second + b->second));
+            a++;
+            b++;
+        }
+    }
+
+    countVec.swap(sumVec);
+    size += other.size;
+    updateMedian();
+}
+
+int ScoreHistogram::scoreAt(int position) const {
+    assert(position >= 0 && position < size);
+    for (auto &p : countVec) {
+        if (position < p.second) {
+            return p.first;
+        }
+        position -= p.second;
+    }
+    return countVec.back().first;
+}
+
+void ScoreHistogram::updateMedian() {
+    int middle = size / 2;
+    if (size % 2 == 1) {
+        median = scoreAt(middle);
+    }
+    else {
+        median = int((scoreAt(middle) + scoreAt(middle - 1)) / 2);
+    }
+}
@@ -0,0 +1,116 @@
+/*
+ * LtrDetector v2.0 annotates LTR retro-transposons in a genome.
+ * 
+ * ScoreTrack
+ * 
+ *  Created on: Oct 17, 2026
+ * Reviewer:
+ *   Purpose: The scores of one strand as runs of equal non-zero scores. Bases without a
+ *            copy in range score 0 and are not stored, so a track costs memory in
+ *            proportion to the repetitive part of the sequence, not to its length.
+ * 
+ * Academic use: Affero General Public License version 1.
+ *
+ * Any restrictions to use for-profit or non-academics: Alternative commercial license is needed.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * 
+ * Please contact Dr. Hani Z. Girgis (hzgirgis@buffalo.edu) if you need more information.
+ * 
+ * Copyright (C) 2022 by the authors.
+ */
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <assert.h>
+
+// Bases [start, end) all scoring score
+struct ScoreRun
+{
+    int start;
+    int end;
+    int score;
+
+    bool operator==(const ScoreRun &other) const {
+        return start == other.start && end == other.end && score == other.score;
+    }
+};
+
+/**
+ * The non-zero scores of a stretch as a count per distinct score, sorted by score.
+ * Two histograms add in time linear in their distinct scores, and the median is
+ * kept up to date, so growing stretches never re-sort their bases.
+ */
+class ScoreHistogram
+{
+private:
+    // Variables
+    // (score, count)
+    std::vector<std::pair<int, int>> countVec;
+    int size;
+    int median;
+
+    // Methods
+    // The score at a position of the sorted scores
+    int scoreAt(int position) const;
+    void updateMedian();
+
+public:
+
+    // Constructor
+    ScoreHistogram(const ScoreRun &run);
+
+    // Getter
+    int getSize() const;
+
+    // Median of the scores; the mean of the middle two, rounded down, if there is an even number
+    int getMedian() const;
+
+    // Methods
+    void add(const ScoreHistogram &other);
+};
+
+class ScoreTrack
+{
+private:
+    // Variables
+    int length;
+    // Sorted and disjoint
+    std::vector<ScoreRun> runVec;
+
+public:
+
+    // Constructor
+
+    // Every base scores 0
+    ScoreTrack(int _length);
+
+    // Getter
+    int getLength() const;
+    std::vector<ScoreRun> *getRuns();
+
+    // Methods
+
+    // Scores the base at index, which must come after every base scored so far
+    inline void append(int index, int score) {
+        assert(score != 0);
+        assert(index >= 0 && index < length);
+        assert(runVec.empty() || index >= runVec.back().end);
+
+        if (!runVec.empty() && runVec.back().end == index && runVec.back().score == score) {
+            runVec.back().end++;
+        }
+        else {
+            runVec.push_back(ScoreRun{index, index + 1, score});
+        }
+    }
+
+    // The score of every base, zeros included
+    std::vector<int> toVector() const;
+
+    bool operator==(const ScoreTrack &other) const;
+};
@@ -20,7 +20,18 @@
  */
 #include "ScorerTr.h"
 
-ScorerTr::ScorerTr(std::string &seqIn, int motifSizeIn, int minIn, int maxIn) : seq(seqIn)
+ScorerTr::ScorerTr(std::string &seqIn, int motifSizeIn, int minIn, int maxIn, Strategy strategy) :
+		ownedSeq(new utility::PackedSequence(seqIn))
+{
+	initialize(*ownedSeq, motifSizeIn, minIn, maxIn, strategy);
+}
+
+ScorerTr::ScorerTr(const utility::PackedSequence &seqIn, int motifSizeIn, int minIn, int maxIn, Strategy strategy)
+{
+	initialize(seqIn, motifSizeIn, minIn, maxIn, strategy);
+}
+
+void ScorerTr::initialize(const utility::PackedSequence &seqIn, int motifSizeIn, int minIn, int maxIn, Strategy strategy)
 {
 	// Pre-conditions
 	assert(motifSizeIn >= 1);
@@ -29,42 +40,62 @@ ScorerTr::ScorerTr(std::string &seqIn, int motifSizeIn, int minIn, int maxIn) :
 	assert(minIn >= 1);
 	assert(maxIn >= 1);
 
-	// seq = seqIn;
+	seq = &seqIn;
 	k = motifSizeIn;
 	min = minIn;
 	max = maxIn;
 
-	kmerTable = new KmerHistogram<int, int>(k);
-
 	// std::cout << LtrParameters::INITIAL_VALUE << std::endl;
 	// std::cout << LtrParameters::INITIAL_SCORE << std::endl;
 
-	int init_score = LtrParameters::INITIAL_SCORE;
-
-	forwardList = new std::vector<int>(seq.size(), init_score);
-	backwardList = new std::vector<int>(seq.size(), init_score);
+	forwardList = new ScoreTrack(seq->size());
+	backwardList = new ScoreTrack(seq->size());
 
-	score();
+	if (strategy == Strategy::AUTO) {
+		strategy = seq->size() < SPARSE_LENGTH ? Strategy::SPARSE : Strategy::DENSE;
+	}
+	if (strategy == Strategy::SPARSE) {
+		SparseLastIndexTable indexTable(seq->size());
+		score(indexTable);
+	}
+	else {
+		// Borrowing the thread's table; resetting it does not touch its 4^k entries
+		LastIndexTable &indexTable = LastIndexTable::forThread(k);
+		indexTable.reset(seq->size());
+		score(indexTable);
+	}
 }
 
 ScorerTr::~ScorerTr()
 {
-	delete kmerTable;
 	if (forwardList != nullptr) {
-		forwardList->clear();
 		delete forwardList;
 	}
 
 	if (backwardList != nullptr) {
-		backwardList->clear();
 		delete backwardList;
 	}
 }
 
-void ScorerTr::score()
+template<class T>
+void ScorerTr::score(T &indexTable)
 {
-	int *indexList = kmerTable->initialize(LtrParameters::INITIAL_VALUE);
-	vector<pair<int, int>> segmentList = kmerTable->makeSegments(&seq);
+	std::vector<std::pair<int, int>> segmentList = seq->makeSegments(0, seq->size());
+
+	// Forward scores land up to max bases behind the current k-mer. They wait in a ring
+	// of max + 1 bases and are appended to the track once no later k-mer can reach them.
+	int ringSize = max + 1;
+	std::vector<int> forwardRing(ringSize, LtrParameters::INITIAL_SCORE);
+	int nextFlush = 0;
+	auto flushForward = [&](int end) {
+		for (; nextFlush < end; nextFlush++) {
+			int &ringScore = forwardRing[nextFlush % ringSize];
+			if (ringScore != LtrParameters::INITIAL_SCORE) {
+				forwardList->append(nextFlush, ringScore);
+				ringScore = LtrParameters::INITIAL_SCORE;
+			}
+		}
+	};
 
 	for (auto segment : segmentList)
 	{
@@ -76,18 +107,14 @@ void ScorerTr::score()
 			continue;
 		}
 
-		vector<int> *hashList = new vector<int>();
-
-		hashList->reserve(end - start - (k - 1));
-
-		//kmerTable->hash(&seq, start, end - k + 2, hashList);
-		kmerTable->hash(&seq, start, end - k, hashList);
-
-		for (int i = start; i <= end - k; i++)
+		// Hashes are read from the packed sequence a block at a time
+		seq->forEachKmer(k, start, end - k, [&](int i, uint64_t hash)
 		{ // Any position at end - k + 2 or greater can't have a kmer of size k
-			int keyHash = hashList->at(i - start);
+			flushForward(i - max);
+
+			int keyHash = static_cast<int>(hash);
 			// Where is the closest previous copy
-			int lastIndex = indexList[keyHash];
+			int lastIndex = indexTable.get(keyHash);
 
 			// There is a copy of this kmer and its location is at lastIndex
 			if (lastIndex != LtrParameters::INITIAL_VALUE)
@@ -96,30 +123,27 @@ void ScorerTr::score()
 				if (dist >= min && dist <= max)
 				{
 					// Look forward
-					forwardList->at(lastIndex) = dist;
+					forwardRing[lastIndex % ringSize] = dist;
 
 					// Look backward
-					backwardList->at(i) = dist;
+					backwardList->append(i, dist);
 				}
 			}
 
-			indexList[keyHash] = i;
-		}
-
-		hashList->clear();
-		delete hashList;
+			indexTable.set(keyHash, i);
+		});
 	}
 
-	delete indexList;
+	flushForward(seq->size());
 }
 
 
-vector<int> *ScorerTr::getForwardScores()
+ScoreTrack *ScorerTr::getForwardScores()
 {
 	return forwardList;
 }
 
-vector<int> *ScorerTr::getBackwardScores()
+ScoreTrack *ScorerTr::getBackwardScores()
 {
 	return backwardList;
 }
@@ -127,12 +151,12 @@ vector<int> *ScorerTr::getBackwardScores()
 void ScorerTr::printForwardScores(std::string fileName)
 {
 	std::stringstream s(std::ios_base::out);
-	for (auto score : *forwardList) {
+	for (auto score : forwardList->toVector()) {
 		s << score << std::endl;
 	}
 
 
-	ofstream out(fileName);
+	std::ofstream out(fileName);
 	out.write(s.str().c_str(), s.str().length());
 	out.close();
 }
@@ -140,26 +164,24 @@ void ScorerTr::printForwardScores(std::string fileName)
 void ScorerTr::printBackwardScores(std::string fileName)
 {
 	std::stringstream s(std::ios_base::out);
-	for (auto score : *backwardList) {
+	for (auto score : backwardList->toVector()) {
 		s << score << std::endl;
 	}
 
 
-	ofstream out(fileName);
+	std::ofstream out(fileName);
 	out.write(s.str().c_str(), s.str().length());
 	out.close();
 }
 
 void ScorerTr::removeForwardScores()
 {
-	forwardList->clear();
 	delete forwardList;
 	forwardList = nullptr;
 }
 
 void ScorerTr::removeBackwardScores()
 {
-	backwardList->clear();
 	delete backwardList;
 	backwardList = nullptr;
 }
\ No newline at end of file
@@ -14,9 +14,12 @@
 #include <fstream>
 #include <assert.h>
 #include <sstream>
+#include <memory>
 
 #include "LtrParameters.h"
-#include "../KmerHistogram.h"
+#include "LastIndexTable.h"
+#include "ScoreTrack.h"
+#include "../utility/PackedSequence.h"
 
 class ScorerTr
 {
@@ -25,8 +28,10 @@ private:
 	 * Variables
 	 */
 
-	// Reference to sequence to score
-	std::string &seq;
+	// Sequence to score
+	const utility::PackedSequence *seq;
+	// Set if the scorer packed the sequence itself
+	std::unique_ptr<utility::PackedSequence> ownedSeq;
 	// Size of k-mer
 	int k;
 	// Minimum score possible; inclusive
@@ -34,9 +39,9 @@ private:
 	// Maximum score possible; inclusive
 	int max;
 
-	KmerHistogram<int, int> *kmerTable;
-	std::vector<int> *forwardList;
-	std::vector<int> *backwardList;
+	// Non-zero scores only; a base scores the distance to its nearest copy in [min, max]
+	ScoreTrack *forwardList;
+	ScoreTrack *backwardList;
 	std::string csvFileName;
 
 	/**
@@ -44,13 +49,27 @@ private:
 	 */
 	void medianSmooth();
 	int findMedian(int, int);
-	void score();
+	template<class T>
+	void score(T &indexTable);
 
 public:
-	ScorerTr(std::string &, int, int, int);
+	/**
+	 * How the last index of each k-mer is kept. DENSE uses the thread's table of all 4^k k-mers;
+	 * SPARSE a table sized to the sequence. Both give the same scores.
+	 * AUTO picks SPARSE for sequences shorter than SPARSE_LENGTH. Below it, scorertrbench
+	 * measures SPARSE as fast as a dense table the thread already holds, and far faster than
+	 * allocating one; above it, the sparse table falls out of cache and DENSE wins.
+	 * A thread that only scores short regions never allocates the 4^k table.
+	 */
+	enum class Strategy { AUTO, DENSE, SPARSE };
+	static const int SPARSE_LENGTH = 1 << 16;
+
+	ScorerTr(std::string &, int, int, int, Strategy strategy = Strategy::AUTO);
+	// Scores a sequence that is already packed, e.g., a chromosome shared with other stages
+	ScorerTr(const utility::PackedSequence &, int, int, int, Strategy strategy = Strategy::AUTO);
 	virtual ~ScorerTr();
-	vector<int> *getForwardScores();
-	vector<int> *getBackwardScores();
+	ScoreTrack *getForwardScores();
+	ScoreTrack *getBackwardScores();
 
 	void scoresFormat(int, int);
 
@@ -59,6 +78,9 @@ public:
 
 	void removeForwardScores();
 	void removeBackwardScores();
+
+private:
+	void initialize(const utility::PackedSequence &, int, int, int, Strategy);
 };
 
 #endif /* SCORERTR_H_ */
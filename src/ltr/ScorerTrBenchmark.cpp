@@ -0,0 +1,132 @@
+/*
+ * LtrDetector v2.0 annotates LTR retro-transposons in a genome.
+ * 
+ * ScorerTrBenchmark
+ * 
+ *  Created on: Oct 17, 2026
+ * Reviewer:
+ *   Purpose: Times ScorerTr's dense and sparse strategies over a range of sequence lengths,
+ *            checks that they give the same scores, and reports where dense becomes faster.
+ *            Dense is timed twice: on a thread that already holds its table, and cold, paying
+ *            for the table as the first sequence a thread scores does.
+ *            ScorerTr::SPARSE_LENGTH is set where sparse stops keeping up with the warm dense table.
+ *            Usage: scorertrbench [fasta file]; without a file, random sequences with planted repeats are used.
+ * 
+ * Academic use: Affero General Public License version 1.
+ *
+ * Any restrictions to use for-profit or non-academics: Alternative commercial license is needed.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * 
+ * Please contact Dr. Hani Z. Girgis (hzgirgis@buffalo.edu) if you need more information.
+ * 
+ * Copyright (C) 2022 by the authors.
+ */
+
+#include "ScorerTr.h"
+#include "LtrParameters.h"
+
+#include "../FastaReader.h"
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+
+namespace {
+
+// Random bases with copies of earlier stretches, so that k-mers repeat at LTR-like distances
+std::string makeSequence(int length, std::mt19937 &gen) {
+    std::string r(length, 'A');
+    for (auto &c : r) {
+        c = "ACGT"[gen() % 4];
+    }
+    for (int i = 0; i + 2 * LtrParameters::MIN_LTR < length; i += 5000) {
+        int copyLength = LtrParameters::MIN_LTR;
+        int source = gen() % (i + 1);
+        r.replace(i, copyLength, r.substr(source, copyLength));
+    }
+    return r;
+}
+
+// Seconds per base, the best of a few rounds
+double timeScorer(std::string &seq, ScorerTr::Strategy strategy, int rounds, bool isCold = false) {
+    double best = -1.0;
+    for (int i = 0; i < rounds; i++) {
+        if (isCold) {
+            LastIndexTable::releaseThreadTable();
+        }
+        auto start = std::chrono::steady_clock::now();
+        ScorerTr st(seq, LtrParameters::K, LtrParameters::MIN_DISTANCE, LtrParameters::MAX_DISTANCE, strategy);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        best = best < 0.0 ? seconds : std::min(best, seconds);
+    }
+    return best / seq.size();
+}
+
+}
+
+int main(int argc, char *argv[]) {
+    std::mt19937 gen(13);
+    std::string source;
+    if (argc > 1) {
+        FastaReader fr(argv[1], 1);
+        Block *block = fr.read();
+        source = *block->at(0).second;
+        FastaReader::deleteBlock(block);
+    }
+
+    // Allocating the thread's dense table before timing; a long run pays this once
+    std::string warmUp = makeSequence(LtrParameters::K * 10, gen);
+    ScorerTr st(warmUp, LtrParameters::K, LtrParameters::MIN_DISTANCE, LtrParameters::MAX_DISTANCE, ScorerTr::Strategy::DENSE);
+
+    std::cout << std::setw(10) << "length" << std::setw(14) << "dense ns/bp" << std::setw(14) << "cold ns/bp" << std::setw(14) << "sparse ns/bp" << std::setw(8) << "same" << std::endl;
+    long long crossover = -1;
+    long long coldCrossover = -1;
+    for (long long length = 1000; length <= 16000000; length *= 2) {
+        std::string seq;
+        if (source.empty()) {
+            seq = makeSequence(length, gen);
+        }
+        else if (length <= source.size()) {
+            seq = source.substr(0, length);
+        }
+        else {
+            break;
+        }
+
+        ScorerTr dense(seq, LtrParameters::K, LtrParameters::MIN_DISTANCE, LtrParameters::MAX_DISTANCE, ScorerTr::Strategy::DENSE);
+        ScorerTr sparse(seq, LtrParameters::K, LtrParameters::MIN_DISTANCE, LtrParameters::MAX_DISTANCE, ScorerTr::Strategy::SPARSE);
+        bool isSame = *dense.getForwardScores() == *sparse.getForwardScores() && *dense.getBackwardScores() == *sparse.getBackwardScores();
+
+        int rounds = std::max(1LL, 4000000 / length);
+        double coldTime = timeScorer(seq, ScorerTr::Strategy::DENSE, std::min(rounds, 3), true);
+        double denseTime = timeScorer(seq, ScorerTr::Strategy::DENSE, rounds);
+        double sparseTime = timeScorer(seq, ScorerTr::Strategy::SPARSE, rounds);
+        if (crossover == -1 && denseTime <= sparseTime) {
+            crossover = length;
+        }
+        if (coldCrossover == -1 && coldTime <= sparseTime) {
+            coldCrossover = length;
+        }
+
+        std::cout << std::setw(10) << length << std::fixed << std::setprecision(2)
+                  << std::setw(14) << denseTime * 1e9 << std::setw(14) << coldTime * 1e9 << std::setw(14) << sparseTime * 1e9
+                  << std::setw(8) << (isSame ? "yes" : "NO") << std::endl;
+        if (!isSame) {
+            std::cerr << "The strategies disagree at length " << length << std::endl;
+            return 1;
+        }
+    }
+
+    auto report = [](std::string name, long long length) {
+        std::cout << name << (length == -1 ? " never catches up with sparse" : " is faster from " + std::to_string(length) + " bp") << std::endl;
+    };
+    report("Dense", crossover);
+    report("Cold dense", coldCrossover);
+    std::cout << "ScorerTr::SPARSE_LENGTH is " << ScorerTr::SPARSE_LENGTH << std::endl;
+    return 0;
+}
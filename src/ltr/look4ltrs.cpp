@@ -12,6 +12,10 @@
 #include "Filter.h"
 #include "PostProcess.h"
 #include "LtrUtility.h"
+#include "GenomeStore.h"
+#include "ElementDB.h"
+#include "MemoryBudget.h"
+#include "Checkpoint.h"
 
 #include "ModulePipeline.h"
 
@@ -29,6 +33,9 @@
 #include <memory>
 #include <unordered_set>
 #include <algorithm>
+#include <numeric>
+#include <sstream>
+#include <limits>
 
 int main(int argc, char*argv[]) {
 
@@ -39,6 +46,11 @@ int main(int argc, char*argv[]) {
     std::string outPath = "";
     std::string configPath = "";
     int pa = 1;
+    double maxMemory = -1.0;
+    double windowSize = 0.0;
+    std::string redModelPath = "";
+    std::string identityModelPath = "";
+    bool resume = false;
     bool help = false;
     std::string helpMessage = 
         "Example of expected input: look4ltrs -fasta /###/###/Fasta/ /###/####/Fasta -out /Output/ -pa 4\n"
@@ -47,6 +59,12 @@ int main(int argc, char*argv[]) {
         "--out/-o  : REQUIRED; output directory; all output files go here\n"
         "--config/-c : library stats for detector module (optional)\n"
         "--parallel/-pa   : number of cores to use\n"
+        "--max-memory/-m  : memory budget in GB; chromosomes run concurrently only while their estimated memory fits; "
+        "Red trains from a scratch file if the genome is over half of the budget\n"
+        "--red-model/-r   : Red model file; reused if trained on the same genomes, otherwise Red is trained and saved here\n"
+        "--identity-model/-i : directory with the Identity models saved by an earlier run (usually its output directory); skips training Identity\n"
+        "--window/-w : window length in Mbp; longer chromosomes are split into overlapping windows that are searched in parallel\n"
+        "--resume  : continues a run that stopped, skipping the stages it finished; give the same arguments and output directory\n"
         "--help/-h : prints out this message";
 
 
@@ -88,6 +106,30 @@ int main(int argc, char*argv[]) {
             pa = pa == -1 ? std::thread::hardware_concurrency() : pa;
             i++;
         }
+        else if (args[i] == "--max-memory" || args[i] == "-m") {
+            i++;
+            maxMemory = std::stod(args[i]);
+            i++;
+        }
+        else if (args[i] == "--red-model" || args[i] == "-r") {
+            i++;
+            redModelPath = args[i];
+            i++;
+        }
+        else if (args[i] == "--identity-model" || args[i] == "-i") {
+            i++;
+            identityModelPath = args[i] + "/";
+            i++;
+        }
+        else if (args[i] == "--window" || args[i] == "-w") {
+            i++;
+            windowSize = std::stod(args[i]);
+            i++;
+        }
+        else if (args[i] == "--resume") {
+            resume = true;
+            i++;
+        }
         else if (args[i] == "--help" || args[i] == "-h") {
             help = true;
             i++;
@@ -161,6 +203,47 @@ int main(int argc, char*argv[]) {
         return 1;
     }
 
+    // Checking memory budget; it is only checked if given
+    if (maxMemory != -1.0 && maxMemory <= 0.0) {
+        std::cerr << "Invalid memory budget: " << maxMemory << std::endl;
+        return 1;
+    }
+
+    // Checking window length; windows must be longer than the overlaps on both of their sides
+    int windowOverlap = LtrParameters::MAX_DISTANCE + LtrParameters::MAX_RT;
+    int windowBases = 0;
+    if (windowSize != 0.0) {
+        if (windowSize * 1e6 <= 2.0 * windowOverlap || windowSize * 1e6 > std::numeric_limits<int>::max()) {
+            std::cerr << "Invalid window length: " << windowSize << std::endl;
+            std::cerr << "Must be over " << 2.0 * windowOverlap / 1e6 << " Mbp" << std::endl;
+            return 1;
+        }
+        windowBases = static_cast<int>(windowSize * 1e6);
+    }
+
+    // Checking the directory of the Red model; the file itself may not exist yet
+    if (!redModelPath.empty()) {
+        std::filesystem::path modelDir = std::filesystem::path(redModelPath).parent_path();
+        if (!modelDir.empty() && !std::filesystem::exists(modelDir)) {
+            std::cerr << modelDir.string() << " does not exist!" << std::endl;
+            std::cerr << "Error in argument --red-model" << std::endl;
+            return 1;
+        }
+    }
+
+    // Identity models are written to the output directory and read back from --identity-model
+    std::string icStandardName = "identity_standard.model";
+    std::string icRecentName = "identity_recent.model";
+    if (!identityModelPath.empty()) {
+        for (auto &name : {icStandardName, icRecentName}) {
+            if (!std::filesystem::exists(identityModelPath + name)) {
+                std::cerr << identityModelPath + name << " does not exist!" << std::endl;
+                std::cerr << "Error in argument --identity-model" << std::endl;
+                return 1;
+            }
+        }
+    }
+
     /**
      * @@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@
      *            COLLECTING FASTA FILES
@@ -230,6 +313,35 @@ int main(int argc, char*argv[]) {
         std::cout << val << std::endl;
     }
 
+    // Every finished per-chromosome stage is checkpointed, so a run that stops can be continued with --resume.
+    // The checkpoint is only resumed for the same files, sizes, roles, and config.
+    std::stringstream fingerprint;
+    for (auto &fastaFile : fastaVec) {
+        fingerprint << fastaFile << "\t" << std::filesystem::file_size(fastaFile) << "\t" << predSet.count(fastaFile) << "\n";
+    }
+    fingerprint << "config\t" << configPath << "\n";
+    fingerprint << "window\t" << windowBases << "\n";
+    Checkpoint checkpoint{outPath, fingerprint.str(), resume};
+
+    // Without --red-model, Red is still saved with the checkpoint so that a resumed run skips its training
+    if (redModelPath.empty()) {
+        redModelPath = checkpoint.getDirPath() + "red.model";
+    }
+
+    // Red reads the genome once for all of its training stages; if the genome is over half of what the budget
+    // leaves after Red's k-mer table, it is kept in a scratch file next to the checkpoints instead of in memory
+    std::optional<std::string> redSpillPath;
+    if (maxMemory > 0.0) {
+        long long fastaBytes = 0;
+        for (auto &fastaFile : fastaVec) {
+            fastaBytes += std::filesystem::file_size(fastaFile);
+        }
+        long long tableBytes = Red::estimateTableMemory(fastaBytes);
+        if (fastaBytes > (maxMemory * 1e9 - tableBytes) / 2) {
+            redSpillPath = checkpoint.getDirPath() + "red.cache";
+        }
+    }
+
     // Training RED
     std::string redTrainPath;
     std::vector<std::filesystem::path> symlinkVec;
@@ -260,8 +372,8 @@ int main(int argc, char*argv[]) {
             redTrainPath = fastaArgVec.at(0);
         }
 
-        // Training Red right here
-        red = std::make_unique<Red>(redTrainPath, pa);
+        // Training Red right here, unless a model trained on the same genomes was saved
+        red = std::make_unique<Red>(redTrainPath, redModelPath, pa, redSpillPath);
     }
     // If we fail somewhere above, remove any created symbolic link.
     catch (std::exception& e) {
@@ -281,140 +393,204 @@ int main(int argc, char*argv[]) {
         std::filesystem::remove_all(redTrainPath);
     }
 
-    // Database path for Identity training
-    std::string dbPath = outPath + "db.fasta";
-    if (std::filesystem::exists(dbPath)) {
-        std::filesystem::remove(dbPath);
+    // Reading every fasta file once; all of the phases below share these chromosomes
+    std::unique_ptr<GenomeStore> storePtr;
+    try {
+        storePtr = std::make_unique<GenomeStore>(fastaVec, pa);
+    }
+    catch (std::length_error &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    GenomeStore &store = *storePtr;
+
+    // The genome, Red's k-mer table, and the last-index table of every thread, which ScorerTr keeps between tasks,
+    // are resident for the whole run; the rest of the budget is for the chromosome tasks
+    long long taskMemory = -1;
+    if (maxMemory > 0.0) {
+        long long threadTables = pa * (1LL << (2 * LtrParameters::K)) * sizeof(int);
+        long long resident = store.getTotalSize() + red->getTableMemory() + threadTables;
+        taskMemory = std::max(0LL, static_cast<long long>(maxMemory * 1e9) - resident);
+        if (taskMemory == 0) {
+            std::cout << "The genome and the k-mer tables alone exceed --max-memory; chromosomes will run one at a time." << std::endl;
+        }
+    }
+    MemoryBudget budget{taskMemory};
+
+    // Every window is a task; without --window, a chromosome is one window and the window ID is the chromosome ID.
+    // Windows of a chromosome overlap by enough to hold an LTR RT whole, plus the distance the scorer looks back.
+    std::vector<GenomeStore::Window> windowVec;
+    std::vector<std::vector<int>> chromWindowVec(store.getChromCount());
+    for (int c = 0; c < store.getChromCount(); c++) {
+        for (auto &window : store.makeWindows(c, windowBases, windowOverlap)) {
+            chromWindowVec.at(c).push_back(windowVec.size());
+            windowVec.push_back(window);
+        }
     }
 
-    // Contains all of the Modules
-    std::unordered_map<std::string, ModulePipeline*> moduleMap;
+    // The largest windows are handed out first; ties keep the ID order
+    auto sortTasks = [&windowVec](std::vector<int> &taskVec) {
+        std::stable_sort(taskVec.begin(), taskVec.end(), [&windowVec](int w1, int w2)
+        {
+            return windowVec.at(w1).length > windowVec.at(w2).length;
+        });
+    };
+    std::vector<int> taskVec(windowVec.size());
+    std::iota(taskVec.begin(), taskVec.end(), 0);
+    sortTasks(taskVec);
+
+    // Contains all of the Modules; the index is the window ID
+    std::vector<ModulePipeline*> moduleVec(windowVec.size(), nullptr);
+    for (int w = 0; w < windowVec.size(); w++) {
+        moduleVec.at(w) = new ModulePipeline{*red, store, windowVec.at(w)};
+    }
 
     // Finding Elements
     std::cout << std::endl;
     std::cout << "Finding Repetitive Elements..." << std::endl;
-    #pragma omp parallel for schedule(static) num_threads(pa)
-    for(int i = 0; i < fastaVec.size(); i++) {
-        std::string fastaPath = fastaVec.at(i);
-        std::string fastaName = LtrUtility::getFileName(fastaPath);
-
-        #pragma omp critical
-        {
-            std::cout << "Parsing " + fastaPath << std::endl;
-        }
-
-        FastaReader fr(fastaPath, 1000);
-        auto block = fr.read();
-        for (auto chrom : *block) {
-
-            std::string chromName = chrom.first->substr(1);
-            std::string chromOut = outPath + fastaName + "_" + chromName;
-
-            #pragma omp critical 
+    // Dynamic scheduling: an idle thread takes the next window in the queue
+    #pragma omp parallel for schedule(dynamic, 1) num_threads(pa)
+    for (int t = 0; t < taskVec.size(); t++) {
+        int w = taskVec.at(t);
+        if (checkpoint.isDone("elements", w)) {
+            if (moduleVec.at(w)->loadElements(checkpoint.getPath("elements", w))) {
+                continue;
+            }
+            #pragma omp critical
             {
-                moduleMap[chromOut] = new ModulePipeline{*red};
+                std::cout << "The elements checkpoint of window " << w << " is damaged; recomputing it." << std::endl;
             }
-            ModulePipeline &mp = *moduleMap[chromOut];
+        }
 
-            // Scoring, Merging, and Detecting elements
-            mp.buildElements(chrom.second);
+        // A window that is not the whole chromosome holds a copy of its bases while it runs
+        long long memory = ModulePipeline::estimateBuildMemory(windowVec.at(w).length);
+        memory += windowVec.at(w).length < store.getSize(windowVec.at(w).chromID) ? windowVec.at(w).length : 0;
+        budget.acquire(memory);
 
+        // Scoring, Merging, and Detecting elements
+        moduleVec.at(w)->buildElements();
 
-        }
-        FastaReader::deleteBlock(block);
+        budget.release(memory);
 
+        moduleVec.at(w)->saveElements(checkpoint.getPath("elements", w));
+        checkpoint.markDone("elements", w);
     }
     
-    std::cout << "Writing Elements to Database..." << std::endl;
-    for (int i = 0; i < fastaVec.size(); i++) {
-        std::string fastaPath = fastaVec.at(i);
-        std::string fastaName = LtrUtility::getFileName(fastaPath);
-
-        FastaReader fr(fastaPath, 1000);
-        auto block = fr.read();
-        for (auto chrom : *block) {
-            std::string chromName = chrom.first->substr(1);
-            std::string chromOut = outPath + fastaName + "_" + chromName;
-
-            // Writing elements to database for Identity training
-            ModulePipeline &mp = *moduleMap[chromOut];
-            mp.writeToDB(dbPath, i, chromName, chrom.second);
+    std::unique_ptr<IdentityCalculator<int32_t>> icStandard;
+    std::unique_ptr<IdentityCalculator<int32_t>> icRecent;
+    // A resumed run reads back the models it saved to the output directory
+    if (identityModelPath.empty() && checkpoint.isDone("identity")) {
+        identityModelPath = outPath;
+    }
+    if (identityModelPath.empty()) {
+        std::cout << "Collecting Elements for Identity..." << std::endl;
+        // Elements are added in chromosome ID order, the order db.fasta was written in; windows of a chromosome are in order
+        ElementDB db{store};
+        for (int w = 0; w < windowVec.size(); w++) {
+            moduleVec.at(w)->addToDB(db);
         }
-        FastaReader::deleteBlock(block);
+
+        // Training Identity; the models are saved so later runs can skip this step
+        std::cout << "Training Identity..." << std::endl;
+        icStandard = LtrUtility::buildCalculator(LtrParameters::MIN_IDENTITY, db, pa, false, outPath + icStandardName);
+        icRecent = LtrUtility::buildCalculator(LtrParameters::MIN_IDENTITY_RECENT, db, pa, true, outPath + icRecentName);
+        checkpoint.markDone("identity");
+    }
+    else {
+        std::cout << "Loading Identity from " << identityModelPath << "..." << std::endl;
+        icStandard = LtrUtility::loadCalculator(LtrParameters::MIN_IDENTITY, identityModelPath + icStandardName, false);
+        icRecent = LtrUtility::loadCalculator(LtrParameters::MIN_IDENTITY_RECENT, identityModelPath + icRecentName, true);
     }
 
+    // Looking for LTR RTs
+    std::cout << "Looking for LTR RTs..." << std::endl;
+    std::vector<int> predFastaVec;
+    taskVec.clear();
+    for (auto &fastaPath : predVec) {
+        int f = store.findFasta(fastaPath);
+        predFastaVec.push_back(f);
+        for (int c : store.getChromIDs(f)) {
+            taskVec.insert(taskVec.end(), chromWindowVec.at(c).begin(), chromWindowVec.at(c).end());
+        }
+    }
+    sortTasks(taskVec);
+
+    #pragma omp parallel for schedule(dynamic, 1) num_threads(pa)
+    for (int t = 0; t < taskVec.size(); t++) {
+        int w = taskVec.at(t);
+        int c = windowVec.at(w).chromID;
+        ModulePipeline &mp = *moduleVec.at(w);
+        if (checkpoint.isDone("final", w)) {
+            if (mp.loadRTs(checkpoint.getPath("final", w))) {
+                continue;
+            }
+            #pragma omp critical
+            {
+                std::cout << "The LTR RT checkpoint of window " << w << " is damaged; recomputing it." << std::endl;
+            }
+        }
 
+        long long memory = ModulePipeline::estimateSearchMemory(windowVec.at(w).length);
+        memory += windowVec.at(w).length < store.getSize(c) ? windowVec.at(w).length : 0;
+        budget.acquire(memory);
 
-    // Training Identity
-    std::cout << "Training Identity..." << std::endl;
-    auto icStandard = LtrUtility::buildCalculator(LtrParameters::MIN_IDENTITY, dbPath, pa, false);
-    auto icRecent = LtrUtility::buildCalculator(LtrParameters::MIN_IDENTITY_RECENT, dbPath, pa, true);
-    std::filesystem::remove(dbPath);
+        mp.matchElements(*icStandard, *icRecent);
+        mp.findRTs();
 
-    // Looking for LTR RTs
-    std::cout << "Looking for LTR RTs..." << std::endl;
-    #pragma omp parallel for schedule(static) num_threads(pa)
-    for(int i = 0; i < predVec.size(); i++) {
-        std::string fastaPath = predVec.at(i);
-        std::string fastaName = LtrUtility::getFileName(fastaPath);
+        // Finding Recently Nested LTR RTs
+        mp.findDeepNests(*icStandard, *icRecent);
 
-        #pragma omp critical
+        // Re-nest the elements and extend the ends of the two LTRs of each RT by k-1; the scoring module loses out on the last k-1 nucleotides by algorithmic design (big word)
+        #pragma omp critical 
         {
-            std::cout << "Parsing " + fastaPath << std::endl;
+            std::cout << "Processing " << store.getName(c) << std::endl;
         }
+        // Processing the elements, nesting, extending
+        mp.process(*icStandard);
 
-        // Output file handlers
-        OutputBed oBed{outPath + "/Bed", fastaPath};
-        OutputRtr oRtr{outPath + "/Rtr", fastaPath};
-        OutputCpx oCpx{outPath + "/Cpx", fastaPath};
+        // Filtering out the LTR RTs that do not meet the structural features of an LTR RT or exhibit high similarity to other repetitive elements
+        mp.filter(*icStandard);
 
-        FastaReader fr(fastaPath, 1000);
-        auto block = fr.read();
+        budget.release(memory);
 
-        for (auto chrom : *block) {
+        mp.saveRTs(checkpoint.getPath("final", w));
+        checkpoint.markDone("final", w);
+    }
 
-            std::string chromName = chrom.first->substr(1);
-            std::string chromOut = outPath + fastaName + "_" + chromName;
+    // Chromosomes finish out of order; writing them in the order they appear in their files
+    for (int f : predFastaVec) {
+        std::string fastaPath = store.getFastaPath(f);
 
-            ModulePipeline &mp = *moduleMap[chromOut];
+        // Output file handlers
+        OutputBed oBed{outPath + "/Bed", fastaPath};
+        OutputRtr oRtr{outPath + "/Rtr", fastaPath};
+        OutputCpx oCpx{outPath + "/Cpx", fastaPath};
 
-            mp.matchElements(*icStandard, *icRecent, chrom.second);
-            mp.findRTs();
+        for (int c : store.getChromIDs(f)) {
+            const std::string &chromName = store.getName(c);
 
             // Found LTR RTs; overall LTR RT vec
-            auto rtVecPtr = mp.getRtVec();
+            std::vector<RT*> rtVec;
             // The complex LTR RT regions
-            auto complexVecPtr = mp.getComplexVec();
-
-            // #pragma omp critical 
-            // {
-            //     std::cout << "Deep Nests " << chromName << std::endl;
-            // }
-
-            // Finding Recently Nested LTR RTs
-            mp.findDeepNests(*icStandard, *icRecent, chrom.second);
+            std::vector<RT*> complexVec;
+            auto rtVecPtr = &rtVec;
+            auto complexVecPtr = &complexVec;
 
-            // std::cout << "Processing" << std::endl;
-            // Re-nest the elements and extend the ends of the two LTRs of each RT by k-1; the scoring module loses out on the last k-1 nucleotides by algorithmic design (big word)
-            #pragma omp critical 
-            {
-                std::cout << "Processing " << chromName << std::endl;
+            std::vector<ModulePipeline*> chromModuleVec;
+            for (int w : chromWindowVec.at(c)) {
+                chromModuleVec.push_back(moduleVec.at(w));
+            }
+            if (chromModuleVec.size() == 1) {
+                rtVecPtr = chromModuleVec.front()->getRtVec();
+                complexVecPtr = chromModuleVec.front()->getComplexVec();
+            }
+            else {
+                // Joining the windows at their seams
+                ModulePipeline::stitch(chromModuleVec, rtVec, complexVec);
             }
-            // Processing the elements, nesting, extending
-            mp.process(*icStandard, chrom.second);
-
-            // #pragma omp critical 
-            // {
-            //     std::cout << "Filter " << chromName << std::endl;
-            // }
-
-            // Filtering out the LTR RTs that do not meet the structural features of an LTR RT or exhibit high similarity to other repetitive elements
-            mp.filter(*icStandard, chrom.second);
-
 
-             
-            // // Writing to output
-            std::cout << "Writing to Output " << *chrom.first << std::endl;
+            // Writing to output
+            std::cout << "Writing to Output >" << chromName << std::endl;
             std::string chromID = chromName.substr(0, chromName.find(" "));
             oBed.write(chromID, *rtVecPtr);
             oRtr.write(chromID, *rtVecPtr);
@@ -426,19 +602,23 @@ int main(int argc, char*argv[]) {
             for (auto& c : *complexVecPtr) {
                 delete c;
             }
-            delete moduleMap[chromOut];
-            moduleMap[chromOut] = nullptr;
+            for (int w : chromWindowVec.at(c)) {
+                delete moduleVec.at(w);
+                moduleVec.at(w) = nullptr;
+            }
         }
-        FastaReader::deleteBlock(block);
     }
 
-    for (auto& [key, value] : moduleMap) {
+    for (auto& value : moduleVec) {
         //value->removeElements();
         if (value != nullptr) {
             delete value;
         }
     }
 
+    // The run is complete; nothing is left to resume
+    checkpoint.remove();
+
     std::cout << "Output written to " << outPath << std::endl;
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,476 @@
+/*
+ * LtrDetector v2.0 annotates LTR retro-transposons in a genome.
+ * 
+ * look4ltrsd
+ * 
+ *  Created on: Oct 17, 2026
+ * Reviewer:
+ *   Purpose: Keeps Red and Identity loaded and annotates the FASTA files dropped into a spool directory.
+ *            A client writes <job>.fa under another name and renames it into the spool directory.
+ *            The daemon moves it to work/, annotates every sequence in it, and renames the finished
+ *            output directory to done/<job>/; files that can not be read or annotated go to failed/.
+ *            A job left in work/ by a daemon that stopped is run once more; if the daemon stops
+ *            again before finishing it, it goes to failed/ at the next start.
+ *            Creating a file named stop in the spool directory ends the daemon.
+ * 
+ * Academic use: Affero General Public License version 1.
+ *
+ * Any restrictions to use for-profit or non-academics: Alternative commercial license is needed.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * 
+ * Please contact Dr. Hani Z. Girgis (hzgirgis@buffalo.edu) if you need more information.
+ * 
+ * Copyright (C) 2022 by the authors.
+ */
+
+#include "LtrAnnotator.h"
+#include "LtrParameters.h"
+#include "LtrUtility.h"
+#include "OutputBed.h"
+#include "OutputRtr.h"
+#include "OutputCpx.h"
+
+#include "../FastaReader.h"
+#include "../red/Red.h"
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <filesystem>
+#include <memory>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <fstream>
+
+namespace {
+
+// The spool directory and the directories the daemon keeps in it
+struct Spool
+{
+    std::string path;
+    std::string workPath;
+    std::string donePath;
+    std::string failedPath;
+    std::string stopPath;
+};
+
+// A FASTA file taken from the spool directory
+struct Job
+{
+    std::string name;
+    std::string fastaPath;
+    std::vector<std::string*> nameVec;
+    std::vector<std::string*> seqVec;
+    std::vector<std::unique_ptr<LtrAnnotation>> annotationVec;
+    bool isRead;
+    // Set by the thread whose sequence could not be annotated; the job's other sequences are skipped
+    std::atomic<bool> isFailed{false};
+    std::chrono::steady_clock::time_point start;
+
+    // Indexes of the sequences, longest first, and the next one to hand out
+    std::vector<int> taskVec;
+    int nextTask = 0;
+    // Bases of the sequences not handed out yet
+    long long pendingBases = 0;
+    // Sequences not annotated yet; the thread that annotates the last one writes the job
+    std::atomic<int> remaining{0};
+};
+
+// Jobs waiting in the spool directory, oldest name first so clients can order their jobs
+std::vector<std::string> findJobs(const std::string &spoolPath) {
+    std::vector<std::string> r;
+    for (auto &entry : std::filesystem::directory_iterator(spoolPath)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".fa") {
+            r.push_back(entry.path().filename().string());
+        }
+    }
+    std::sort(r.begin(), r.end());
+    return r;
+}
+
+bool readJob(Job &job) {
+    try {
+        FastaReader fr(job.fastaPath, 1000);
+        while (fr.isStillReading()) {
+            Block *block = fr.read();
+            for (auto &chrom : *block) {
+                job.nameVec.push_back(chrom.first);
+                job.seqVec.push_back(chrom.second);
+            }
+            delete block;
+        }
+    }
+    catch (std::exception &e) {
+        for (int s = 0; s < job.seqVec.size(); s++) {
+            delete job.nameVec.at(s);
+            delete job.seqVec.at(s);
+        }
+        job.nameVec.clear();
+        job.seqVec.clear();
+        return false;
+    }
+    return true;
+}
+
+std::string getRetryPath(const Spool &spool, const std::string &name) {
+    return spool.workPath + name + ".retry";
+}
+
+// Claiming a job; renaming is atomic, so a job is never read half-written
+std::unique_ptr<Job> claimJob(const Spool &spool, const std::string &fileName) {
+    auto job = std::make_unique<Job>();
+    job->start = std::chrono::steady_clock::now();
+    job->name = std::filesystem::path(fileName).stem().string();
+    job->fastaPath = spool.workPath + fileName;
+    std::filesystem::rename(spool.path + fileName, job->fastaPath);
+    job->isRead = readJob(*job);
+    job->annotationVec.resize(job->seqVec.size());
+
+    for (int s = 0; s < job->seqVec.size(); s++) {
+        job->taskVec.push_back(s);
+        job->pendingBases += job->seqVec.at(s)->size();
+    }
+    std::stable_sort(job->taskVec.begin(), job->taskVec.end(), [&job](int s1, int s2)
+    {
+        return job->seqVec.at(s1)->size() > job->seqVec.at(s2)->size();
+    });
+    job->remaining = job->taskVec.size();
+    return job;
+}
+
+// Writing a job to a hidden directory first, so done/<job>/ only appears once it is complete
+void finishJob(const Spool &spool, Job &job) {
+    if (!job.isRead) {
+        #pragma omp critical
+        {
+            std::cerr << "Could not read " << job.name << ".fa; moved to " << spool.failedPath << std::endl;
+        }
+        std::filesystem::rename(job.fastaPath, spool.failedPath + job.name + ".fa");
+    }
+    else if (job.isFailed) {
+        #pragma omp critical
+        {
+            std::cerr << "Could not annotate " << job.name << ".fa; moved to " << spool.failedPath << std::endl;
+        }
+        std::filesystem::rename(job.fastaPath, spool.failedPath + job.name + ".fa");
+    }
+    else {
+        std::string tempPath = spool.donePath + "." + job.name + "/";
+        std::filesystem::remove_all(tempPath);
+        std::filesystem::create_directory(tempPath);
+
+        OutputBed oBed{tempPath + "Bed", job.fastaPath};
+        OutputRtr oRtr{tempPath + "Rtr", job.fastaPath};
+        OutputCpx oCpx{tempPath + "Cpx", job.fastaPath};
+        for (int s = 0; s < job.seqVec.size(); s++) {
+            std::string chromName = job.nameVec.at(s)->substr(1);
+            std::string chromID = chromName.substr(0, chromName.find(" "));
+            auto rtVec = job.annotationVec.at(s)->getRtVec();
+            auto complexVec = job.annotationVec.at(s)->getComplexVec();
+            oBed.write(chromID, rtVec);
+            oRtr.write(chromID, rtVec);
+            oCpx.write(chromID, complexVec);
+        }
+
+        std::filesystem::remove_all(spool.donePath + job.name);
+        std::filesystem::rename(tempPath, spool.donePath + job.name);
+        std::filesystem::remove(job.fastaPath);
+    }
+    std::filesystem::remove(getRetryPath(spool, job.name));
+
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - job.start).count();
+    #pragma omp critical
+    {
+        std::cout << "Finished " << job.name << ": " << job.seqVec.size() << " sequences in " << ms << " ms" << std::endl;
+    }
+
+    for (int s = 0; s < job.seqVec.size(); s++) {
+        delete job.nameVec.at(s);
+        delete job.seqVec.at(s);
+    }
+}
+
+}
+
+int main(int argc, char*argv[]) {
+
+    std::vector<std::string> args(argv + 1, argv + argc);
+
+    std::string spoolPath = "";
+    std::string redModelPath = "";
+    std::string identityModelPath = "";
+    int pa = 1;
+    int poll = 100;
+    bool help = false;
+    std::string helpMessage = 
+        "Example of expected input: look4ltrsd --spool /spool/ --red-model /Output/red.model --identity-model /Output/ -pa 4\n"
+        "--spool/-s : REQUIRED; directory that jobs are dropped into; each job is a .fa file\n"
+        "--red-model/-r : REQUIRED; Red model file saved by look4ltrs --red-model\n"
+        "--identity-model/-i : REQUIRED; directory with the Identity models saved by look4ltrs (its output directory)\n"
+        "--parallel/-pa : number of cores to use; shared by the sequences of all waiting jobs\n"
+        "--poll : milliseconds between looks at the spool directory; 100 by default\n"
+        "--help/-h : prints out this message";
+
+
+    /**
+     * @@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@
+     *                  ARGUMENT PARSING
+     * @@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@
+    */
+    int i = 0;
+    while (i < args.size()) {
+        if (args[i] == "--spool" || args[i] == "-s") {
+            i++;
+            spoolPath = args[i] + "/";
+            i++;
+        }
+        else if (args[i] == "--red-model" || args[i] == "-r") {
+            i++;
+            redModelPath = args[i];
+            i++;
+        }
+        else if (args[i] == "--identity-model" || args[i] == "-i") {
+            i++;
+            identityModelPath = args[i] + "/";
+            i++;
+        }
+        else if (args[i] == "--parallel" || args[i] == "-pa") {
+            i++;
+            pa = std::stoi(args[i]);
+            pa = pa == -1 ? std::thread::hardware_concurrency() : pa;
+            i++;
+        }
+        else if (args[i] == "--poll") {
+            i++;
+            poll = std::stoi(args[i]);
+            i++;
+        }
+        else if (args[i] == "--help" || args[i] == "-h") {
+            help = true;
+            i++;
+        }
+        else {
+            std::cerr << "Invalid argument: " << args[i] << std::endl;
+            return 1;
+        }
+    }
+
+
+    /**
+     * @@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@
+     *                  ARGUMENT VALIDATION
+     * @@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@
+    */
+    if (help || argc == 1) {
+        std::cout << helpMessage << std::endl;
+        return 0;
+    }
+
+    if (spoolPath.empty() || redModelPath.empty() || identityModelPath.empty()) {
+        std::cerr << "--spool, --red-model, and --identity-model are necessary parameters!" << std::endl;
+        return 1;
+    }
+
+    if (!std::filesystem::exists(spoolPath)) {
+        std::cerr << spoolPath << " does not exist!" << std::endl;
+        std::cerr << "Error in argument --spool" << std::endl;
+        return 1;
+    }
+
+    if (!std::filesystem::exists(redModelPath)) {
+        std::cerr << redModelPath << " does not exist!" << std::endl;
+        std::cerr << "Error in argument --red-model" << std::endl;
+        return 1;
+    }
+
+    std::string icStandardName = "identity_standard.model";
+    std::string icRecentName = "identity_recent.model";
+    for (auto &name : {icStandardName, icRecentName}) {
+        if (!std::filesystem::exists(identityModelPath + name)) {
+            std::cerr << identityModelPath + name << " does not exist!" << std::endl;
+            std::cerr << "Error in argument --identity-model" << std::endl;
+            return 1;
+        }
+    }
+
+    if (pa < 1) {
+        std::cerr << "Invalid number of cores: " << pa << std::endl;
+        return 1;
+    }
+    if (pa > std::thread::hardware_concurrency()) {
+        std::cerr << "Number of cores exceeds hardware concurrency!" << std::endl;
+        return 1;
+    }
+
+    if (poll < 1) {
+        std::cerr << "Invalid poll interval: " << poll << std::endl;
+        return 1;
+    }
+
+
+    /**
+     * @@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@
+     *                  MAIN CODE
+     * @@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@
+    */
+
+    // Loading the models once; every job shares them
+    std::unique_ptr<Red> red;
+    std::unique_ptr<IdentityCalculator<int32_t>> icStandard;
+    std::unique_ptr<IdentityCalculator<int32_t>> icRecent;
+    try {
+        red = Red::fromModel(redModelPath, pa);
+        icStandard = LtrUtility::loadCalculator(LtrParameters::MIN_IDENTITY, identityModelPath + icStandardName, false);
+        icRecent = LtrUtility::loadCalculator(LtrParameters::MIN_IDENTITY_RECENT, identityModelPath + icRecentName, true);
+    }
+    catch (std::exception &e) {
+        std::cerr << "Could not load the models." << std::endl;
+        return 1;
+    }
+    LtrAnnotator annotator{*red, *icStandard, *icRecent};
+
+    Spool spool{spoolPath, spoolPath + "work/", spoolPath + "done/", spoolPath + "failed/", spoolPath + "stop"};
+    for (auto &dirPath : {spool.workPath, spool.donePath, spool.failedPath}) {
+        std::filesystem::create_directories(dirPath);
+    }
+
+    // A job left in work/ by a daemon that stopped is run once more and marked as retried;
+    // a retried job found in work/ may be what stops the daemon, so it goes to failed/
+    std::vector<std::filesystem::path> leftVec;
+    for (auto &entry : std::filesystem::directory_iterator(spool.workPath)) {
+        leftVec.push_back(entry.path());
+    }
+    for (auto &leftPath : leftVec) {
+        if (leftPath.extension() == ".retry" && !std::filesystem::exists(spool.workPath + leftPath.stem().string() + ".fa")) {
+            std::filesystem::remove(leftPath);
+        }
+    }
+    for (auto &leftPath : leftVec) {
+        if (leftPath.extension() != ".fa") {
+            continue;
+        }
+        std::string name = leftPath.stem().string();
+        if (std::filesystem::exists(getRetryPath(spool, name))) {
+            std::cerr << "The daemon stopped twice while annotating " << name << ".fa; moved to " << spool.failedPath << std::endl;
+            std::filesystem::rename(leftPath, spool.failedPath + name + ".fa");
+            std::filesystem::remove(getRetryPath(spool, name));
+        }
+        else {
+            std::ofstream{getRetryPath(spool, name)};
+            std::filesystem::rename(leftPath, spool.path + leftPath.filename().string());
+        }
+    }
+
+    // Every thread annotates one sequence at a time and, every poll interval, one of them claims the waiting jobs,
+    // so a job that arrives while others run is started as soon as a thread is free. The thread that annotates
+    // the last sequence of a job writes the job right away.
+    std::vector<std::unique_ptr<Job>> jobVec;
+    auto lastPoll = std::chrono::steady_clock::now() - std::chrono::milliseconds(poll);
+    bool isPolling = false;
+    bool isStopping = false;
+
+    std::cout << "Waiting for jobs in " << spoolPath << std::endl;
+    #pragma omp parallel num_threads(pa)
+    {
+        while (true) {
+            Job *job = nullptr;
+            int s = -1;
+            bool isPoller = false;
+            bool isDone = false;
+            #pragma omp critical(jobQueue)
+            {
+                auto now = std::chrono::steady_clock::now();
+                if (!isStopping && !isPolling && now - lastPoll >= std::chrono::milliseconds(poll)) {
+                    isPolling = true;
+                    isPoller = true;
+                    lastPoll = now;
+                }
+                else {
+                    // The job with the fewest bases left goes first, so short jobs do not wait behind long ones
+                    for (auto &candidate : jobVec) {
+                        if (candidate->nextTask < candidate->taskVec.size() && (job == nullptr || candidate->pendingBases < job->pendingBases)) {
+                            job = candidate.get();
+                        }
+                    }
+                    if (job != nullptr) {
+                        s = job->taskVec.at(job->nextTask);
+                        job->nextTask++;
+                        job->pendingBases -= job->seqVec.at(s)->size();
+                    }
+                    isDone = job == nullptr && isStopping;
+                }
+            }
+
+            if (isPoller) {
+                bool isStop = std::filesystem::exists(spool.stopPath);
+                std::vector<std::unique_ptr<Job>> claimedVec;
+                if (!isStop) {
+                    for (auto &fileName : findJobs(spool.path)) {
+                        claimedVec.push_back(claimJob(spool, fileName));
+                    }
+                }
+                #pragma omp critical(jobQueue)
+                {
+                    for (auto &claimed : claimedVec) {
+                        if (!claimed->taskVec.empty()) {
+                            jobVec.push_back(std::move(claimed));
+                        }
+                    }
+                    isStopping = isStop;
+                    isPolling = false;
+                }
+                // Jobs that could not be read, or have no sequences, are finished right away
+                for (auto &claimed : claimedVec) {
+                    if (claimed != nullptr) {
+                        finishJob(spool, *claimed);
+                    }
+                }
+                continue;
+            }
+
+            if (job == nullptr) {
+                if (isDone) {
+                    break;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(poll));
+                continue;
+            }
+
+            // One bad sequence fails its job; the daemon and the other jobs carry on
+            if (!job->isFailed) {
+                try {
+                    job->annotationVec.at(s) = std::make_unique<LtrAnnotation>(annotator.annotate(*job->seqVec.at(s)));
+                }
+                catch (...) {
+                    job->isFailed = true;
+                    #pragma omp critical
+                    {
+                        std::cerr << "Could not annotate " << job->nameVec.at(s)->substr(1) << " of " << job->name << ".fa" << std::endl;
+                    }
+                }
+            }
+
+            if (--job->remaining == 0) {
+                std::unique_ptr<Job> finished;
+                #pragma omp critical(jobQueue)
+                {
+                    auto it = std::find_if(jobVec.begin(), jobVec.end(), [job](const std::unique_ptr<Job> &active)
+                    {
+                        return active.get() == job;
+                    });
+                    finished = std::move(*it);
+                    jobVec.erase(it);
+                }
+                finishJob(spool, *finished);
+            }
+        }
+    }
+
+    std::filesystem::remove(spool.stopPath);
+    std::cout << "Stopped." << std::endl;
+    return 0;
+}
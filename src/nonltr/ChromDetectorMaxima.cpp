@@ -11,22 +11,22 @@ namespace nonltr {
 
 ChromDetectorMaxima::ChromDetectorMaxima(double s, double w, double m,
 		double t, double p, int e, vector<int> * oScores,
-		ChromosomeOneDigit * chrom) {
+		ChromosomeOneDigit * chrom, bool isFast) {
 	header = chrom->getHeader();
-	start(s, w, m, t, p, e, oScores, chrom->getSegment());
+	start(s, w, m, t, p, e, oScores, chrom->getSegment(), isFast);
 
 }
 
 ChromDetectorMaxima::ChromDetectorMaxima(double s, double w, double m,
 		double t, double p, int e, vector<int> * oScores, const vector<vector<
-				int> *> * segmentList) {
+				int> *> * segmentList, bool isFast) {
 	header = string("chrUnknown");
-	start(s, w, m, t, p, e, oScores, segmentList);
+	start(s, w, m, t, p, e, oScores, segmentList, isFast);
 }
 
 void ChromDetectorMaxima::start(double s, double w, double m, double t,
 		double p, int e, vector<int> * oScores,
-		const vector<vector<int> *> * segmentList) {
+		const vector<vector<int> *> * segmentList, bool isFast) {
 
 	regionList = new vector<ILocation *> ();
 
@@ -41,7 +41,7 @@ void ChromDetectorMaxima::start(double s, double w, double m, double t,
 
 		if (segLen > effLen) {
 			DetectorMaxima * detector = new DetectorMaxima(segStart, segEnd, s,
-					w, m, t, p, e, oScores);
+					w, m, t, p, e, oScores, isFast);
 
 			const vector<ILocation *> * segRegions = detector->getRegionList();
 			int segRegionCount = segRegions->size();
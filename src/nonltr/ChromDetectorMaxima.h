@@ -29,13 +29,14 @@ private:
 	string header;
 
 	void start(double, double, double, double, double, int, vector<int> *,
-			const vector<vector<int> *> *);
+			const vector<vector<int> *> *, bool);
 
 public:
+	// The last parameter selects the fast smoother of DetectorMaxima
 	ChromDetectorMaxima(double, double, double, double, double, int,
-			vector<int> *, ChromosomeOneDigit *);
+			vector<int> *, ChromosomeOneDigit *, bool = false);
 	ChromDetectorMaxima(double, double, double, double, double, int,
-			vector<int> *, const vector<vector<int> *> *);
+			vector<int> *, const vector<vector<int> *> *, bool = false);
 	virtual ~ChromDetectorMaxima();
 	const vector<ILocation*>* getRegionList() const;
 	void printIndex(string);
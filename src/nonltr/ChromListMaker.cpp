@@ -138,5 +138,10 @@ const vector<Chromosome *> * ChromListMaker::makeChromOneDigitList() {
 	return chromList;
 }
 
+void ChromListMaker::moveChromList(vector<Chromosome *>& otherList) {
+	otherList.insert(otherList.end(), chromList->begin(), chromList->end());
+	chromList->clear();
+}
+
 }
 /* namespace nonltr */
@@ -32,6 +32,8 @@ public:
 	const vector<Chromosome *> * makeChromList();
 	//void makeChromList(vector<Chromosome *>&);
 	const vector<Chromosome *> * makeChromOneDigitList();
+	// The caller takes over the chromosomes made so far
+	void moveChromList(vector<Chromosome *>&);
 };
 
 } /* namespace nonltr */
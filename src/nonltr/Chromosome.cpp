@@ -44,6 +44,67 @@ Chromosome::Chromosome(string &seq, string &info, int len) {
 	help(len, true);
 }
 
+Chromosome::Chromosome(istream &in) {
+	int headerLength;
+	in.read(reinterpret_cast<char *>(&headerLength), sizeof(int));
+	header = string(in ? headerLength : 0, ' ');
+	in.read(&header[0], header.size());
+
+	int baseLength;
+	in.read(reinterpret_cast<char *>(&baseLength), sizeof(int));
+	base = string(in ? baseLength : 0, ' ');
+	in.read(&base[0], base.size());
+
+	in.read(reinterpret_cast<char *>(&segLength), sizeof(int));
+	in.read(reinterpret_cast<char *>(&effectiveSize), sizeof(int));
+
+	int segmentCount;
+	in.read(reinterpret_cast<char *>(&segmentCount), sizeof(int));
+	segment = new vector<vector<int> *>();
+	for (int i = 0; in && i < segmentCount; i++) {
+		int s;
+		int e;
+		in.read(reinterpret_cast<char *>(&s), sizeof(int));
+		in.read(reinterpret_cast<char *>(&e), sizeof(int));
+		segment->push_back(new vector<int> { s, e });
+	}
+
+	if (!in) {
+		Util::deleteInVector(segment);
+		delete segment;
+		string msg("Could not read a chromosome.");
+		throw InvalidInputException(msg);
+	}
+
+	isHeaderReady = true;
+	isBaseReady = true;
+	isFinalized = true;
+}
+
+/**
+ * Writes the header, the sequence as it is, and the segments.
+ * The chromosome must be finalized or built from a file or a sequence.
+ */
+void Chromosome::write(ostream &out) {
+	int headerLength = header.size();
+	out.write(reinterpret_cast<const char *>(&headerLength), sizeof(int));
+	out.write(header.data(), headerLength);
+
+	int baseLength = base.size();
+	out.write(reinterpret_cast<const char *>(&baseLength), sizeof(int));
+	out.write(base.data(), baseLength);
+
+	out.write(reinterpret_cast<const char *>(&segLength), sizeof(int));
+	out.write(reinterpret_cast<const char *>(&effectiveSize), sizeof(int));
+
+	int segmentCount = segment->size();
+	out.write(reinterpret_cast<const char *>(&segmentCount), sizeof(int));
+	for (int i = 0; i < segmentCount; i++) {
+		out.write(reinterpret_cast<const char *>(segment->at(i)->data()),
+				2 * sizeof(int));
+	}
+}
+
 void Chromosome::setHeader(string& info) {
 	if (isFinalized) {
 		string msg("This chromosome has been finalized. ");
@@ -32,8 +32,9 @@ public:
 	Chromosome(string, int);
 	Chromosome(string &, string&);
 	Chromosome(string &, string&, int);
+	Chromosome(istream &); // Build a finalized chromosome written by write
 
-	int getGcContent();
+	virtual int getGcContent();
 
 	virtual ~Chromosome();
 
@@ -47,6 +48,7 @@ public:
 	virtual void setSequence(string&);
 	virtual void appendToSequence(string&);
 	virtual void finalize();
+	virtual void write(ostream &);
 
 
 protected:
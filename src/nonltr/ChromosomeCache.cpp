@@ -0,0 +1,148 @@
+/*
+ * ChromosomeCache.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "ChromosomeCache.h"
+
+namespace nonltr {
+
+ChromosomeCache::ChromosomeCache(string genomeDir) {
+	isSpilled = false;
+	build(genomeDir);
+}
+
+ChromosomeCache::ChromosomeCache(string genomeDir, string spillFileIn) {
+	isSpilled = true;
+	spillFile = spillFileIn;
+	build(genomeDir);
+}
+
+ChromosomeCache::~ChromosomeCache() {
+	for (vector<Chromosome *> * chromList : *chromListList) {
+		if (chromList != nullptr) {
+			Util::deleteInVector(chromList);
+			delete chromList;
+		}
+	}
+	delete chromListList;
+	delete offsetList;
+	delete countList;
+	fileList->clear();
+	delete fileList;
+
+	if (isSpilled) {
+		remove(spillFile.c_str());
+	}
+}
+
+void ChromosomeCache::build(string genomeDir) {
+	fileList = new vector<string>();
+	Util::readChromList(genomeDir, fileList, "fa");
+	int fileCount = fileList->size();
+
+	chromListList = new vector<vector<Chromosome *> *>(fileCount, nullptr);
+	offsetList = new vector<streamoff>(fileCount, 0);
+	countList = new vector<int>(fileCount, 0);
+
+	ofstream out;
+	if (isSpilled) {
+		out.open(spillFile.c_str(), ios::binary | ios::trunc);
+		if (!out) {
+			string msg("Could not open the scratch file: ");
+			msg.append(spillFile);
+			throw InvalidInputException(msg);
+		}
+	}
+
+	long genomeLength = 0;
+	long genomeGc = 0;
+
+	# pragma omp parallel for schedule(dynamic) num_threads(Util::CORE_NUM) \
+	reduction(+: genomeLength, genomeGc)
+	for (int i = 0; i < fileCount; i++) {
+		# pragma omp critical
+		{
+			cout << "Reading " << fileList->at(i) << " ..." << endl;
+		}
+		ChromListMaker * maker = new ChromListMaker(fileList->at(i));
+		const vector<Chromosome *> * chromList = maker->makeChromOneDigitList();
+
+		for (unsigned int h = 0; h < chromList->size(); h++) {
+			genomeLength += chromList->at(h)->getEffectiveSize();
+			genomeGc += chromList->at(h)->getGcContent();
+		}
+		(*countList)[i] = chromList->size();
+
+		if (isSpilled) {
+			# pragma omp critical(spill)
+			{
+				(*offsetList)[i] = out.tellp();
+				for (unsigned int h = 0; h < chromList->size(); h++) {
+					chromList->at(h)->write(out);
+				}
+			}
+		} else {
+			(*chromListList)[i] = new vector<Chromosome *>();
+			maker->moveChromList(*(*chromListList)[i]);
+		}
+
+		delete maker;
+	}
+
+	if (isSpilled) {
+		out.close();
+		if (!out) {
+			string msg("Could not write the scratch file: ");
+			msg.append(spillFile);
+			throw InvalidInputException(msg);
+		}
+	}
+
+	effectiveSize = genomeLength;
+	gcContent = genomeGc;
+}
+
+int ChromosomeCache::getFileCount() {
+	return fileList->size();
+}
+
+string ChromosomeCache::getFile(int i) {
+	return fileList->at(i);
+}
+
+long ChromosomeCache::getEffectiveSize() {
+	return effectiveSize;
+}
+
+long ChromosomeCache::getGcContent() {
+	return gcContent;
+}
+
+const vector<Chromosome *> * ChromosomeCache::getChromList(int i) {
+	if (!isSpilled) {
+		return chromListList->at(i);
+	}
+
+	vector<Chromosome *> * chromList = new vector<Chromosome *>();
+	ifstream in(spillFile.c_str(), ios::binary);
+	in.seekg(offsetList->at(i));
+	for (int h = 0; h < countList->at(i); h++) {
+		chromList->push_back(new ChromosomeOneDigit(in));
+	}
+	in.close();
+
+	return chromList;
+}
+
+void ChromosomeCache::releaseChromList(const vector<Chromosome *> * chromList) {
+	if (isSpilled) {
+		for (Chromosome * chrom : *chromList) {
+			delete chrom;
+		}
+		delete chromList;
+	}
+}
+
+} /* namespace nonltr */
@@ -0,0 +1,71 @@
+/*
+ * ChromosomeCache.h
+ *
+ *  Created on: Oct 17, 2026
+ *
+ * The chromosomes of a genome directory, read, upper-cased, segmented, and
+ * encoded once, for the stages of training to iterate as many times as needed.
+ * The encoded chromosomes stay in memory, or are spilled to a scratch file and
+ * read back one FASTA file at a time, which skips parsing and encoding.
+ */
+
+#ifndef CHROMOSOMECACHE_H_
+#define CHROMOSOMECACHE_H_
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <cstdio>
+
+#include "Chromosome.h"
+#include "ChromosomeOneDigit.h"
+#include "ChromListMaker.h"
+
+#include "../utility/Util.h"
+#include "../exception/InvalidInputException.h"
+
+using namespace std;
+using namespace utility;
+using namespace exception;
+
+namespace nonltr {
+
+class ChromosomeCache {
+private:
+	vector<string> * fileList;
+	// The chromosomes of each file; the lists are not kept if spilled
+	vector<vector<Chromosome *> *> * chromListList;
+
+	bool isSpilled;
+	string spillFile;
+	// Where the chromosomes of each file start in the scratch file, and how many
+	vector<streamoff> * offsetList;
+	vector<int> * countList;
+
+	long effectiveSize;
+	long gcContent;
+
+	void build(string);
+
+public:
+	ChromosomeCache(string);
+	// Spills the chromosomes to the scratch file, which is removed with the cache
+	ChromosomeCache(string, string);
+	virtual ~ChromosomeCache();
+
+	int getFileCount();
+	string getFile(int);
+	long getEffectiveSize();
+	long getGcContent();
+
+	/**
+	 * The ChromosomeOneDigit's of a file. Every list must be handed back
+	 * to releaseChromList; different files may be in use at the same time.
+	 */
+	const vector<Chromosome *> * getChromList(int);
+	void releaseChromList(const vector<Chromosome *> *);
+};
+
+} /* namespace nonltr */
+#endif /* CHROMOSOMECACHE_H_ */
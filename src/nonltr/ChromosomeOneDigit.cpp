@@ -44,6 +44,25 @@ ChromosomeOneDigit::ChromosomeOneDigit(string seq, string info) :
 	help();
 }
 
+ChromosomeOneDigit::ChromosomeOneDigit(istream &in) :
+		Chromosome(in) {
+	in.read(reinterpret_cast<char *>(&gcContent), sizeof(int));
+	if (!in) {
+		string msg("Could not read a chromosome.");
+		throw InvalidInputException(msg);
+	}
+	buildCodes();
+}
+
+void ChromosomeOneDigit::write(ostream &out) {
+	Chromosome::write(out);
+	out.write(reinterpret_cast<const char *>(&gcContent), sizeof(int));
+}
+
+int ChromosomeOneDigit::getGcContent() {
+	return gcContent;
+}
+
 void ChromosomeOneDigit::help() {
 	// Build codes
 	buildCodes();
@@ -93,11 +112,15 @@ ChromosomeOneDigit::~ChromosomeOneDigit() {
  * This method converts nucleotides in the segments to single digit codes
  */
 void ChromosomeOneDigit::encodeNucleotides() {
+  gcContent = 0;
 
   for (unsigned int s = 0; s < segment->size(); s++) {
     int segStart = segment->at(s)->at(0);
     int segEnd = segment->at(s)->at(1);
     for (int i = segStart; i <= segEnd; i++) {
+      if (base[i] == 'C' || base[i] == 'G') {
+	gcContent++;
+      }
       if (codes->count(base[i]) > 0) {
 		base[i] = codes->at(base[i]);
       } else {
@@ -118,6 +141,9 @@ void ChromosomeOneDigit::encodeNucleotides() {
     for (int s = 0; s <= segNum; s++) {      
       for (int i = segStart; i <= segEnd; i++) {
 	char c = base[i];
+	if (c == 'C' || c == 'G') {
+	  gcContent++;
+	}
 	if(c != 'N'){
 	  if (codes->count(c) > 0) {
 	    base[i] = codes->at(c);
@@ -17,6 +17,8 @@ class ChromosomeOneDigit: public Chromosome {
 private:
 	/* Fields */
 	map<char, char> * codes;
+	// C's and G's, counted before the bases are encoded
+	int gcContent;
 
 	/* Methods */
 	void help();
@@ -32,8 +34,11 @@ public:
 	ChromosomeOneDigit();
 	ChromosomeOneDigit(string);
 	ChromosomeOneDigit(string, string);
+	ChromosomeOneDigit(istream &); // Build a chromosome written by write
 	virtual ~ChromosomeOneDigit();
 	virtual void finalize();
+	virtual int getGcContent();
+	virtual void write(ostream &);
 
 	void makeR();
 	void makeRC();
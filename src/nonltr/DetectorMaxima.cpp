@@ -22,7 +22,7 @@ namespace nonltr {
 
 DetectorMaxima::DetectorMaxima(int segStartIn, int segEndIn, double sIn,
 		double wIn, double mIn, double tIn, double pIn, int eIn,
-		vector<int> * oScoresIn) {
+		vector<int> * oScoresIn, bool isFast) {
 
 	// ToDo: make sure that segStart and segEnd are within the input scores.
 	segStart = segStartIn;
@@ -38,7 +38,6 @@ DetectorMaxima::DetectorMaxima(int segStartIn, int segEndIn, double sIn,
 	halfS = s;
 	//s / 2;
 
-	mask = new vector<double>();
 	// Complete
 	scores = new vector<double>();
 
@@ -60,17 +59,13 @@ DetectorMaxima::DetectorMaxima(int segStartIn, int segEndIn, double sIn,
 	// Coordinates according to the complete sequence
 	regionList = new vector<ILocation *>();
 
-	makeMask();
-
-	smooth();
+	smoothScores(oScores, segStart, segEnd, s, isFast, scores);
 
 	deriveFirst();
 
 	deriveSecond();
 
 	// Free memory start
-	mask->clear();
-	delete mask;
 	scores->clear();
 	delete scores;
 	// Free memory end
@@ -129,7 +124,20 @@ DetectorMaxima::~DetectorMaxima() {
 	delete regionList;
 }
 
-void DetectorMaxima::makeMask() {
+void DetectorMaxima::smoothScores(vector<int> * oScores, int segStart,
+		int segEnd, double s, bool isFast, vector<double> * scores) {
+	if (isFast) {
+		smoothBoxes(oScores, segStart, segEnd, s, scores);
+	} else {
+		vector<double> * mask = new vector<double>();
+		makeMask(s, mask);
+		smooth(oScores, segStart, segEnd, s, mask, scores);
+		mask->clear();
+		delete mask;
+	}
+}
+
+void DetectorMaxima::makeMask(double s, vector<double> * mask) {
 	const double PI = 3.14159265358979323846;
 	double sigma = (double) s / 3.5;
 	const double PART_1 = 1 / sqrt(2 * PI * pow(sigma, 2));
@@ -151,7 +159,8 @@ void DetectorMaxima::makeMask() {
 	// End testing
 }
 
-void DetectorMaxima::smooth() {
+void DetectorMaxima::smooth(vector<int> * oScores, int segStart, int segEnd,
+		double s, const vector<double> * mask, vector<double> * scores) {
 	for (int i = segStart; i <= segEnd; i++) {
 		int winS = i - s;
 		int maskS = 0;
@@ -202,6 +211,72 @@ void DetectorMaxima::smooth() {
 	// Testing - end
 }
 
+/**
+ * Three passes of box filters make a kernel close to a Gaussian. The widths are
+ * odd, so every box is centered, and are chosen to match the variance of the
+ * mask (Kovesi, Fast almost-Gaussian filtering, 2010). A pass is a difference of
+ * prefix sums, so it takes constant time per score.
+ *
+ * The scores outside the segment are zeros, and a second buffer filters the
+ * indicator of the segment the same way; it holds the sum of the weights inside
+ * the segment, which is what the mask is renormalized by. The intermediate
+ * passes spread past the segment, so both buffers are padded by the sum of the
+ * radii. Everything is an integer until the final division, hence exact.
+ */
+void DetectorMaxima::smoothBoxes(vector<int> * oScores, int segStart,
+		int segEnd, double s, vector<double> * scores) {
+	const int BOX_NUM = 3;
+	double sigma = (double) s / 3.5;
+	double var = 12 * sigma * sigma;
+
+	int wl = floor(sqrt(var / BOX_NUM + 1));
+	if (wl % 2 == 0) {
+		wl--;
+	}
+	int wu = wl + 2;
+	int m = std::round(
+			(var - BOX_NUM * wl * wl - 4 * BOX_NUM * wl - 3 * BOX_NUM)
+					/ (-4 * wl - 4));
+
+	int radiusList[BOX_NUM];
+	int pad = 0;
+	for (int i = 0; i < BOX_NUM; i++) {
+		radiusList[i] = ((i < m ? wl : wu) - 1) / 2;
+		pad += radiusList[i];
+	}
+
+	int segLen = segEnd - segStart + 1;
+	int bufLen = segLen + 2 * pad;
+	vector<long long> sumList(bufLen, 0);
+	vector<long long> weightList(bufLen, 0);
+	for (int i = 0; i < segLen; i++) {
+		sumList[pad + i] = oScores->at(segStart + i);
+		weightList[pad + i] = 1;
+	}
+
+	vector<long long> prefixList(bufLen + 1);
+	vector<long long> * bufList[] = { &sumList, &weightList };
+	for (int h = 0; h < BOX_NUM; h++) {
+		int r = radiusList[h];
+		for (vector<long long> * buf : bufList) {
+			prefixList[0] = 0;
+			for (int i = 0; i < bufLen; i++) {
+				prefixList[i + 1] = prefixList[i] + (*buf)[i];
+			}
+			for (int i = 0; i < bufLen; i++) {
+				int winE = min(bufLen, i + r + 1);
+				int winS = max(0, i - r);
+				(*buf)[i] = prefixList[winE] - prefixList[winS];
+			}
+		}
+	}
+
+	scores->reserve(scores->size() + segLen);
+	for (int i = pad; i < pad + segLen; i++) {
+		scores->push_back((double) sumList[i] / weightList[i]);
+	}
+}
+
 void DetectorMaxima::deriveFirst() {
 	double l = 0.0;
 	double r = 0.0;
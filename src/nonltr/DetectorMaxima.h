@@ -33,7 +33,6 @@ private:
 
 	vector<int> * oScores;
 	vector<double> * scores;
-	vector<double> * mask;
 	vector<double> * first;
 	vector<double> * second;
 	vector<int> * maxima;
@@ -42,8 +41,10 @@ private:
 	vector<ILocation *> * separatorList;
 	vector<ILocation *> * regionList;
 
-	void makeMask();
-	void smooth();
+	static void makeMask(double, vector<double> *);
+	static void smooth(vector<int> *, int, int, double, const vector<double> *,
+			vector<double> *);
+	static void smoothBoxes(vector<int> *, int, int, double, vector<double> *);
 	void deriveFirst();
 	void deriveSecond();
 	void findMaxima();
@@ -64,13 +65,24 @@ private:
 
 public:
 	DetectorMaxima(int, int, double, double, double, double, double, int,
-			vector<int> *);
+			vector<int> *, bool = false);
 	virtual ~DetectorMaxima();
 	const vector<ILocation*>* getRegionList() const;
 	const vector<double>* getFirst() const;
 	const vector<double>* getSecond() const;
 
 	// const vector<vector<double> *>* getAllMaxima() const;
+
+	/**
+	 * Appends the scores from segStart to segEnd, both inclusive, smoothed by a
+	 * Gaussian mask of half width s. Near the ends of the segment, the sum is
+	 * divided by the weights that fall inside the segment.
+	 *
+	 * If isFast is true, the mask is approximated by three box filters with the
+	 * same variance. This takes constant time per score instead of time linear in s.
+	 */
+	static void smoothScores(vector<int> *, int, int, double, bool,
+			vector<double> *);
 };
 
 } /* namespace nonltr */
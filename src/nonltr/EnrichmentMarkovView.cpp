@@ -18,8 +18,8 @@ EnrichmentMarkovView<I, V>::EnrichmentMarkovView(int k, int order, int m) :
 
 template<class I, class V>
 EnrichmentMarkovView<I, V>::EnrichmentMarkovView(int k, V initValue, int order,
-		int m) :
-		minObs(m), factor(10000.00), KmerHashTable<I, V>(k, initValue) {
+		int m, bool isCompact) :
+		minObs(m), factor(10000.00), KmerHashTable<I, V>(k, initValue, isCompact) {
 	initialize(order);
 }
 
@@ -87,7 +87,9 @@ void EnrichmentMarkovView<I, V>::count(const char * sequence, int start,
 
 	// Multiple by 2 if scanning the forward strand and its reverse complement
 	// l = l + (2 * (end - start + 1));
-	l = l + (end - start + 1);
+	// Segments of other chromosomes are counted at the same time
+	# pragma omp atomic
+	l += end - start + 1;
 
 	int modelNumber = modelList->size();
 	for (int i = 0; i < modelNumber; i++) {
@@ -223,12 +225,12 @@ void EnrichmentMarkovView<I, V>::processTable() {
 			// Requirement: if observed is >= 5 && observed > expected then the value is the difference
 			// otherwise the value is zero
 
-			V observed = KmerHashTable<I, V>::values[y];
+			V observed = KmerHashTable<I, V>::valueAt(y);
 
 			if (observed >= minObs && observed > exp) {
-				KmerHashTable<I, V>::values[y] = round(observed - exp);
+				KmerHashTable<I, V>::setValue(y, round(observed - exp));
 			} else {
-				KmerHashTable<I, V>::values[y] = 0;
+				KmerHashTable<I, V>::setValue(y, 0);
 			}
 
 			/*
@@ -63,7 +63,8 @@ private:
 
 public:
 	EnrichmentMarkovView(int, int, int);
-	EnrichmentMarkovView(int, V, int, int);
+	// The last argument makes the table compact, see KmerHashTable
+	EnrichmentMarkovView(int, V, int, int, bool = false);
 	virtual ~EnrichmentMarkovView();
 
 	void count(const char *, int, int);
@@ -119,6 +119,29 @@ HMM::HMM(string hmmFile) {
 	in.close();
 }
 
+/**
+ * Reads a normalized model in the binary format of write.
+ * The caller checks the state of the stream.
+ */
+HMM::HMM(istream &in) {
+	double baseIn;
+	int stateNumberIn;
+	in.read(reinterpret_cast<char *>(&baseIn), sizeof(double));
+	in.read(reinterpret_cast<char *>(&stateNumberIn), sizeof(int));
+	if (!in) {
+		string msg("Cannot read the HMM.");
+		throw InvalidInputException(msg);
+	}
+	initialize(baseIn, stateNumberIn);
+
+	in.read(reinterpret_cast<char *>(pList->data()), sizeof(double) * stateNumber);
+	for (int i = 0; i < stateNumber; i++) {
+		in.read(reinterpret_cast<char *>(tList->at(i)->data()), sizeof(double) * stateNumber);
+	}
+	in.read(reinterpret_cast<char *>(oList->data()), sizeof(double) * stateNumber);
+	normalized = true;
+}
+
 /**
  * Use this constructor to train on the entire genome.
  * The client has to call train on each chromosome.
@@ -331,6 +354,34 @@ void HMM::move(int state1, int state2) {
 	(*state1Row)[state2] = state1Row->at(state2) + 1;
 }
 
+/**
+ * Adds the counts another model was trained on to the counts of this one.
+ * Both start every count at one; the other's initial ones are not added.
+ * The counts are whole numbers, so the sum does not depend on the order.
+ */
+void HMM::addCounts(HMM & other) {
+	if (normalized || other.normalized) {
+		string msg("Only the counts of models not normalized yet can be added.");
+		throw InvalidStateException(msg);
+	}
+	if (stateNumber != other.getStateNumber()) {
+		string msg("The models must have the same number of states.");
+		throw InvalidInputException(msg);
+	}
+
+	vector<vector<double> *> * otherTList = other.getTList();
+	for (int i = 0; i < stateNumber; i++) {
+		(*pList)[i] += other.getPList()->at(i) - 1;
+		(*oList)[i] += other.getOList()->at(i) - 1;
+
+		vector<double> * row = tList->at(i);
+		vector<double> * otherRow = otherTList->at(i);
+		for (int j = 0; j < stateNumber; j++) {
+			(*row)[j] += otherRow->at(j) - 1;
+		}
+	}
+}
+
 void HMM::normalize() {
 	if (normalized) {
 		cerr << "HMM already normalized.  Exiting..." << endl;
@@ -456,144 +507,130 @@ void HMM::print(string hmo) {
 }
 
 /**
- * This method will append the state sequence to the end of the input state list
+ * Writes the model in binary; the values are written exactly, unlike print.
+ */
+void HMM::write(ostream &out) {
+	if (!normalized) {
+		string msg("The HMM must be normalized before it is written.");
+		throw InvalidStateException(msg);
+	}
+
+	out.write(reinterpret_cast<const char *>(&base), sizeof(double));
+	out.write(reinterpret_cast<const char *>(&stateNumber), sizeof(int));
+	out.write(reinterpret_cast<const char *>(pList->data()), sizeof(double) * stateNumber);
+	for (int i = 0; i < stateNumber; i++) {
+		out.write(reinterpret_cast<const char *>(tList->at(i)->data()), sizeof(double) * stateNumber);
+	}
+	out.write(reinterpret_cast<const char *>(oList->data()), sizeof(double) * stateNumber);
+}
+
+/**
+ * Viterbi over the two states a base can be in: the positive and the negative
+ * state of its score. Every other state scores minus infinity at that base, so
+ * only the scores of the two best paths ending at the current base are kept.
+ * Each base gets a bit per state, packed two bits per base; a set bit means the
+ * best path to that state comes from the positive state of the previous base.
+ *
+ * The best path is written to pathList, a bit per base from rStart to rEnd, both
+ * inclusive; a set bit is a positive state.
  * This method returns the log likelihood
  */
-double HMM::decode(int rStart, int rEnd, vector<int> * scoreListIn,
-		vector<int>& stateList) {
+double HMM::decodePath(int rStart, int rEnd, vector<int> * scoreListIn,
+		vector<uint64_t>& pathList) {
 	scoreList = scoreListIn;
 
 	// Make sure that the coordinates represent valid location
 	Location check(rStart, rEnd);
+	if (rEnd >= (int) scoreList->size()) {
+		string msg("The region ends after the last score.");
+		throw InvalidInputException(msg);
+	}
 	// End check
 
-	vector<vector<double> > v(stateNumber);
 	int size = rEnd - rStart + 1;
-	for (int i = 0; i < stateNumber; i++) {
-		v[i] = vector<double>(size, minusInf);
-	}
 
-	vector<vector<int> > p(stateNumber);
+	// The transitions in one row-major block
+	vector<double> transition(stateNumber * stateNumber);
 	for (int i = 0; i < stateNumber; i++) {
-		p[i] = vector<int>(size, -1);
+		vector<double> * row = tList->at(i);
+		for (int j = 0; j < stateNumber; j++) {
+			transition[i * stateNumber + j] = row->at(j);
+		}
 	}
+	const double * t = transition.data();
+	const int * score = scoreList->data();
+	const int lastPstvState = (stateNumber - 2) / 2;
+
+	vector<uint64_t> backList((size + 31) / 32, 0);
 
 	// Initialize
-	int firstPstvState = getPstvState(rStart);
-	int firstNgtvState = positiveStateNumber + firstPstvState;
-	v[firstPstvState][0] = pList->at(firstPstvState);
-	v[firstNgtvState][0] = pList->at(firstNgtvState);
+	int pPstvState = min(score[rStart], lastPstvState);
+	double pstvValue = pList->at(pPstvState);
+	double ngtvValue = pList->at(positiveStateNumber + pPstvState);
 
 	// Recurs
 	for (int i = rStart + 1; i <= rEnd; i++) {
 		int vIndex = i - rStart;
-
-		// Obtain states from scores
-		int pPstvState = getPstvState(i - 1);
-		int pNgtvState = positiveStateNumber + pPstvState;
-		int cPstvState = getPstvState(i);
-		int cNgtvState = positiveStateNumber + cPstvState;
+		int cPstvState = min(score[i], lastPstvState);
+		const double * pPstvRow = t + pPstvState * stateNumber;
+		const double * pNgtvRow = t + (positiveStateNumber + pPstvState) * stateNumber;
+		uint64_t & back = backList[vIndex / 32];
+		int shift = 2 * (vIndex % 32);
 
 		// Set positive state
-		double p1 = v[pPstvState][vIndex - 1]
-				+ (*(*tList)[pPstvState])[cPstvState];
-		double p2 = v[pNgtvState][vIndex - 1]
-				+ (*(*tList)[pNgtvState])[cPstvState];
+		double p1 = pstvValue + pPstvRow[cPstvState];
+		double p2 = ngtvValue + pNgtvRow[cPstvState];
+		double cPstvValue = p2;
 		if (p1 > p2) {
-			v[cPstvState][vIndex] = p1;
-			p[cPstvState][vIndex] = pPstvState;
-		} else {
-			v[cPstvState][vIndex] = p2;
-			p[cPstvState][vIndex] = pNgtvState;
+			cPstvValue = p1;
+			back |= 1ULL << shift;
 		}
 
 		// Set negative state
-		double p3 = v[pPstvState][vIndex - 1]
-				+ (*(*tList)[pPstvState])[cNgtvState];
-		double p4 = v[pNgtvState][vIndex - 1]
-				+ (*(*tList)[pNgtvState])[cNgtvState];
+		double p3 = pstvValue + pPstvRow[positiveStateNumber + cPstvState];
+		double p4 = ngtvValue + pNgtvRow[positiveStateNumber + cPstvState];
+		double cNgtvValue = p4;
 		if (p3 > p4) {
-			v[cNgtvState][vIndex] = p3;
-			p[cNgtvState][vIndex] = pPstvState;
-		} else {
-			v[cNgtvState][vIndex] = p4;
-			p[cNgtvState][vIndex] = pNgtvState;
-		}
-	}
-
-	// Decode
-	int lastBestState = 0;
-	double lastBestValue = v[0][size - 1];
-	for (int i = 1; i < stateNumber; i++) {
-		double currentValue = v[i][size - 1];
-		if (currentValue > lastBestValue) {
-			lastBestState = i;
-			lastBestValue = currentValue;
+			cNgtvValue = p3;
+			back |= 2ULL << shift;
 		}
-	}
 
-	int stateListOriginalSize = stateList.size();
-	for (int i = stateListOriginalSize; i < stateListOriginalSize + size; i++) {
-		stateList.push_back(-1);
+		pstvValue = cPstvValue;
+		ngtvValue = cNgtvValue;
+		pPstvState = cPstvState;
 	}
 
-	stateList[stateListOriginalSize + size - 1] = lastBestState;
-	for (int i = size - 1; i > 0; i--) {
-		lastBestState = p[lastBestState][i];
-		stateList[stateListOriginalSize + i - 1] = lastBestState;
-	}
+	// Decode; on a tie, the positive state, which has the lower index, is kept
+	bool isPstv = !(ngtvValue > pstvValue);
+	double lastBestValue = isPstv ? pstvValue : ngtvValue;
 
-	// Make sure that no state in the results has the value of -1
-	for (int i = stateListOriginalSize; i < stateListOriginalSize + size; i++) {
-		if (stateList[i] == -1) {
-			string msg("At least one state was not determined properly.");
-			throw InvalidStateException(msg);
+	pathList.assign((size + 63) / 64, 0);
+	for (int i = size - 1; i >= 0; i--) {
+		if (isPstv) {
+			pathList[i / 64] |= 1ULL << (i % 64);
 		}
+		int shift = 2 * (i % 32) + (isPstv ? 0 : 1);
+		isPstv = (backList[i / 32] >> shift) & 1;
 	}
 
 	return lastBestValue;
 }
 
 /**
- * Append positive regions at the end of regionList
+ * This method will append the state sequence to the end of the input state list
+ * This method returns the log likelihood
  */
 double HMM::decode(int rStart, int rEnd, vector<int> * scoreListIn,
-		vector<ILocation *>& regionList) {
-
-	vector<int> stateList;
-	double logLikelihood = decode(rStart, rEnd, scoreListIn, stateList);
-
-	int size = stateList.size();
-	bool inRpt = false;
-	bool canFill = false;
-	int s = -1;
-	int e = -1;
+		vector<int>& stateList) {
+	vector<uint64_t> pathList;
+	double logLikelihood = decodePath(rStart, rEnd, scoreListIn, pathList);
 
+	int size = rEnd - rStart + 1;
+	stateList.reserve(stateList.size() + size);
 	for (int i = 0; i < size; i++) {
-		// Start a new repeat
-		if (stateList.at(i) < positiveStateNumber && !inRpt) {
-			inRpt = true;
-			s = i;
-		}
-		// End a the current repeat
-		else if (stateList.at(i) >= positiveStateNumber && inRpt) {
-			e = i - 1;
-			inRpt = false;
-			canFill = true;
-		}
-		// If the current repeat at the end of the segment
-		else if (i == size - 1 && inRpt) {
-			e = i;
-			inRpt = false;
-			canFill = true;
-		}
-		// Extract features of the just recognized repeat
-		if (canFill) {
-			regionList.push_back(new Location(s + rStart, e + rStart));
-			s = -1;
-			e = -1;
-			canFill = false;
-		}
+		bool isPstv = (pathList[i / 64] >> (i % 64)) & 1;
+		stateList.push_back(
+				isPstv ? getPstvState(rStart + i) : getNgtvState(rStart + i));
 	}
 
 	return logLikelihood;
@@ -602,26 +639,27 @@ double HMM::decode(int rStart, int rEnd, vector<int> * scoreListIn,
 /**
  * Append positive regions at the end of regionList
  */
-double HMM::decodeNew(int rStart, int rEnd, vector<int> * scoreListIn,
+double HMM::decode(int rStart, int rEnd, vector<int> * scoreListIn,
 		vector<ILocation *>& regionList) {
 
-	vector<int> stateList;
-	double logLikelihood = decodeNew(rStart, rEnd, scoreListIn, stateList);
+	vector<uint64_t> pathList;
+	double logLikelihood = decodePath(rStart, rEnd, scoreListIn, pathList);
 
-	int size = stateList.size();
+	int size = rEnd - rStart + 1;
 	bool inRpt = false;
 	bool canFill = false;
 	int s = -1;
 	int e = -1;
 
 	for (int i = 0; i < size; i++) {
+		bool isPstv = (pathList[i / 64] >> (i % 64)) & 1;
 		// Start a new repeat
-		if (stateList.at(i) < positiveStateNumber && !inRpt) {
+		if (isPstv && !inRpt) {
 			inRpt = true;
 			s = i;
 		}
 		// End a the current repeat
-		else if (stateList.at(i) >= positiveStateNumber && inRpt) {
+		else if (!isPstv && inRpt) {
 			e = i - 1;
 			inRpt = false;
 			canFill = true;
@@ -644,117 +682,6 @@ double HMM::decodeNew(int rStart, int rEnd, vector<int> * scoreListIn,
 	return logLikelihood;
 }
 
-//replacement Viterbi Algorithm function
-// Cased a crash on chromosome 20 but worked on 21
-double HMM::decodeNew(int rStart, int rEnd, vector<int> * scoreListIn,
-		vector<int>& stateList) {
-	if (!normalized) {
-		cerr
-				<< "Invalid operation: HMM cannot be traversed until after it is normalized.  Exiting..."
-				<< endl;
-		exit(0);
-	}
-	// print();
-	scoreList = scoreListIn;
-	int len = rEnd - rStart;
-	stateList.resize(len);
-
-	// Make sure that the coordinates represent valid location (copied from current method)
-	Location check(rStart, rEnd);
-	// End check
-
-	//this is a simple list of the probabilities and previous states
-	//the list will hold pairs of the score, and a boolean making + or -, which will indicate whether the state came from a + or - previous state
-	vector<pair<double, bool> > stateProbs(len * 2 + 2);
-
-	//start the list by adding the prior probabilities
-	int firstPstvState = getPstvState(rStart);
-	int firstNgtvState = positiveStateNumber + firstPstvState;
-
-	stateProbs.at(0).first = pList->at(firstPstvState);
-	stateProbs.at(1).first = pList->at(firstNgtvState);
-
-	//compute the most likely transition at each and point and record if it was from + or -
-	// int score, j;
-	int j;
-	double p1, p2, p3, p4;
-
-	for (int i = rStart + 1; i <= rEnd; i++) {
-		j = i - rStart;
-
-		int pPstvState = getPstvState(i - 1);
-		int pNgtvState = positiveStateNumber + pPstvState;
-		int cPstvState = getPstvState(i);
-		int cNgtvState = positiveStateNumber + cPstvState;
-
-		p1 = stateProbs.at(2 * j - 2).first
-				+ (*(*tList)[pPstvState])[cPstvState];
-
-		p2 = stateProbs.at(2 * j - 1).first
-				+ (*(*tList)[pNgtvState])[cPstvState];
-
-		if (p1 > p2) {
-			stateProbs.at(2 * j).first = p1;
-			stateProbs.at(2 * j).second = true;
-		} else {
-			stateProbs.at(2 * j).first = p2;
-			stateProbs.at(2 * j).second = false;
-		}
-		//- to - probability *check this syntax*
-		p3 = stateProbs.at(2 * j - 1).first
-				+ (*(*tList)[pNgtvState])[cNgtvState];
-
-		//- to + probability *check this syntax*
-		p4 = stateProbs.at(2 * j - 2).first
-				+ (*(*tList)[pPstvState])[cNgtvState];
-
-		if (p4 > p3) {
-			stateProbs.at(2 * j + 1).first = p4;
-			stateProbs.at(2 * j + 1).second = true;
-		} else {
-			stateProbs.at(2 * j + 1).first = p3;
-			stateProbs.at(2 * j + 1).second = false;
-		}
-	}
-	//backtrack through the table to generate the complete state list
-	int k = len * 2;
-	if (stateProbs[k].first < stateProbs[len * 2 + 1].first) {
-		k += 1;
-	}
-	bool sign = stateProbs[k].second;
-	while (k >= 0) {
-
-		if (k % 2 == 0) {
-			//adds the positive state of this index's emission to the state list. *ask if format is good*
-			stateList[k / 2] = scoreList->at(rStart + k / 2);
-			if (sign) {
-				k -= 2;
-			} else {
-				k -= 1;
-			}
-		} else {
-			//adds the negative state of this index's emission to the state list.  *ask if format is good*
-			stateList[(k - 1) / 2] = scoreList->at(rStart + (k) / 2)
-					+ positiveStateNumber;
-			if (sign) {
-				k -= 3;
-			} else {
-				k -= 2;
-			}
-		}
-		if (k > -1) {
-			sign = stateProbs[k].second;
-		}
-
-	}
-	if (stateProbs[len * 2 + 1].first > stateProbs[len * 2].first) {
-		return stateProbs[len * 2 + 1].first;
-	} else {
-		return stateProbs[len * 2].first;
-	}
-	delete scoreList;
-}
-
 vector<double>* HMM::getOList() {
 	return oList;
 }
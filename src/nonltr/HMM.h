@@ -9,6 +9,7 @@
 #define HMM_H_
 
 #include <vector>
+#include <cstdint>
 #include <math.h>
 #include <limits>
 #include <stdlib.h>
@@ -38,6 +39,7 @@ private:
 	void trainNegative(int, int);
 	void move(int, int);
 	void checkBase(double);
+	double decodePath(int, int, vector<int> *, vector<uint64_t>&);
 
 	inline int getPstvState(int index) {
 		int state = scoreList->at(index);
@@ -75,19 +77,20 @@ protected:
 
 public:
 	HMM(string); // Build a model from file
+	HMM(istream &); // Build a normalized model written by write
 	HMM(double, int);
 	HMM(HMM&);
 	virtual ~HMM();
 	void train(vector<int> *, const vector<vector<int> *> *,
 			const vector<ILocation*> *);
+	void addCounts(HMM &);
 	void normalize();
 	double decode(int, int, vector<int> *, vector<int>&);
 	double decode(int, int, vector<int> *, vector<ILocation *>&);
-	double decodeNew(int, int, vector<int> *, vector<int>&);
-	double decodeNew(int, int, vector<int> *, vector<ILocation *>&);
 
 	void print();
 	void print(string);
+	void write(ostream &);
 
 	vector<double> * getPList();
 	vector<vector<double> *> * getTList();
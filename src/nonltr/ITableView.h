@@ -10,6 +10,8 @@
 
 #include <vector>
 
+#include "../utility/PackedSequence.h"
+
 using namespace std;
 
 namespace nonltr {
@@ -27,6 +29,7 @@ public:
 
 	virtual void wholesaleValueOf(const char *, int, int, vector<V> *) = 0;
 	virtual void wholesaleValueOf(const char *, int, int, vector<V> *, int) = 0;
+	virtual void wholesaleValueOf(const utility::PackedSequence &, int, int, vector<V> *, int) = 0;
 };
 
 }
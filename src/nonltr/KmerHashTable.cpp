@@ -20,16 +20,25 @@ using namespace utility;
 
 template<class I, class V>
 KmerHashTable<I, V>::KmerHashTable(int keyLength) {
-	initialize(keyLength, 0);
+	initialize(keyLength, 0, false);
 }
 
 template<class I, class V>
 KmerHashTable<I, V>::KmerHashTable(int keyLength, V initValue) {
-	initialize(keyLength, initValue);
+	initialize(keyLength, initValue, false);
 }
 
+/**
+ * A compact table keeps 2 bytes per k-mer. Values that do not fit in
+ * 16 bits, e.g. the counts of the most frequent k-mers, are kept in a map.
+ */
 template<class I, class V>
-void KmerHashTable<I, V>::initialize(int keyLength, V initialValueIn) {
+KmerHashTable<I, V>::KmerHashTable(int keyLength, V initValue, bool isCompactIn) {
+	initialize(keyLength, initValue, isCompactIn);
+}
+
+template<class I, class V>
+void KmerHashTable<I, V>::initialize(int keyLength, V initialValueIn, bool isCompactIn) {
 	/*
 	 if (keyLength > maxKeyLength) {
 	 string msg = "The maximum size (k) of the k-mer is ";
@@ -42,11 +51,16 @@ void KmerHashTable<I, V>::initialize(int keyLength, V initialValueIn) {
 
 	k = keyLength;
 	initialValue = initialValueIn;
+	isCompact = isCompactIn;
+	isFrozen = false;
 
 	// Initialize bases
+	// Powers of 4 are multiplied out; pow may round 4^i down under -ffast-math
 	bases = new I[k];
+	I power = 1;
 	for (int i = k - 1; i >= 0; i--) {
-		bases[k - 1 - i] = (I) pow(4.0, i);
+		bases[i] = power;
+		power *= 4;
 	}
 
 	// Initialize mMinusOne
@@ -65,9 +79,27 @@ void KmerHashTable<I, V>::initialize(int keyLength, V initialValueIn) {
 	delete[] temp;
 
 	// Initialize values
-	values = new V[maxTableSize];
-	for (I i = 0; i < maxTableSize; i++) {
-		values[i] = initialValue;
+	if (isCompact) {
+		if (initialValue < 0 || initialValue >= ESCAPE) {
+			string msg("The initial value of a compact table must be ");
+			msg.append("between 0 and ");
+			msg.append(utility::Util::int2string(ESCAPE - 1));
+			msg.append(".");
+			throw InvalidInputException(msg);
+		}
+		values = nullptr;
+		compactValues = new uint16_t[maxTableSize];
+		for (I i = 0; i < maxTableSize; i++) {
+			compactValues[i] = initialValue;
+		}
+		overflowMap = new unordered_map<I, V>();
+	} else {
+		values = new V[maxTableSize];
+		for (I i = 0; i < maxTableSize; i++) {
+			values[i] = initialValue;
+		}
+		compactValues = nullptr;
+		overflowMap = nullptr;
 	}
 
 	// Test
@@ -87,6 +119,134 @@ KmerHashTable<I, V>::~KmerHashTable() {
 	delete[] bases;
 	delete[] mMinusOne;
 	delete[] values;
+	delete[] compactValues;
+	delete overflowMap;
+}
+
+/**
+ * The value of an escaped entry of a compact table.
+ */
+template<class I, class V>
+V KmerHashTable<I, V>::overflowValueAt(I keyHash) {
+	if (isFrozen) {
+		auto it = lower_bound(frozenOverflow.begin(), frozenOverflow.end(), keyHash,
+				[](const pair<I, V> &entry, I key) {
+					return entry.first < key;
+				});
+		return it != frozenOverflow.end() && it->first == keyHash ? it->second : initialValue;
+	}
+
+	V value = initialValue;
+	# pragma omp critical(kmerOverflow)
+	{
+		auto it = overflowMap->find(keyHash);
+		if (it != overflowMap->end()) {
+			value = it->second;
+		}
+	}
+	return value;
+}
+
+/**
+ * Set an entry of the table. Threads may set different entries at the same time.
+ */
+template<class I, class V>
+void KmerHashTable<I, V>::setValue(I keyHash, V value) {
+	if (isFrozen) {
+		thaw();
+	}
+
+	if (!isCompact) {
+		values[keyHash] = value;
+	} else if (value >= 0 && value < ESCAPE) {
+		if (compactValues[keyHash] == ESCAPE) {
+			# pragma omp critical(kmerOverflow)
+			{
+				overflowMap->erase(keyHash);
+			}
+		}
+		compactValues[keyHash] = value;
+	} else {
+		# pragma omp critical(kmerOverflow)
+		{
+			(*overflowMap)[keyHash] = value;
+		}
+		compactValues[keyHash] = ESCAPE;
+	}
+}
+
+/**
+ * Add a positive count to an entry of a compact table. Other threads may
+ * add to the same entry. The part of the count that goes past 16 bits is
+ * added to localMap, which the caller hands to addOverflow.
+ */
+template<class I, class V>
+void KmerHashTable<I, V>::addValue(I keyHash, V count,
+		unordered_map<I, V> &localMap) {
+	uint16_t * entry = &compactValues[keyHash];
+	uint16_t old = __atomic_load_n(entry, __ATOMIC_RELAXED);
+	while (true) {
+		if (old == ESCAPE) {
+			localMap[keyHash] += count;
+			return;
+		}
+		V sum = old + count;
+		uint16_t next = sum < ESCAPE ? sum : ESCAPE;
+		if (__atomic_compare_exchange_n(entry, &old, next, false,
+				__ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+			if (next == ESCAPE) {
+				localMap[keyHash] += sum;
+			}
+			return;
+		}
+	}
+}
+
+template<class I, class V>
+void KmerHashTable<I, V>::addOverflow(unordered_map<I, V> &localMap) {
+	if (localMap.empty()) {
+		return;
+	}
+	if (isFrozen) {
+		thaw();
+	}
+	# pragma omp critical(kmerOverflow)
+	{
+		for (auto &entry : localMap) {
+			(*overflowMap)[entry.first] += entry.second;
+		}
+	}
+}
+
+/**
+ * Call after building or reading a compact table. Reads of escaped entries
+ * then search a sorted list without a lock, so the table must not be changed
+ * while other threads read it; changing it thaws it.
+ */
+template<class I, class V>
+void KmerHashTable<I, V>::freeze() {
+	if (!isCompact || isFrozen) {
+		return;
+	}
+	frozenOverflow.assign(overflowMap->begin(), overflowMap->end());
+	sort(frozenOverflow.begin(), frozenOverflow.end());
+	overflowMap->clear();
+	isFrozen = true;
+}
+
+/**
+ * Move the escaped entries back to overflowMap before changing the table.
+ */
+template<class I, class V>
+void KmerHashTable<I, V>::thaw() {
+	# pragma omp critical(kmerOverflow)
+	{
+		if (isFrozen) {
+			overflowMap->insert(frozenOverflow.begin(), frozenOverflow.end());
+			vector<pair<I, V>>().swap(frozenOverflow);
+			isFrozen = false;
+		}
+	}
 }
 
 /**
@@ -174,12 +334,12 @@ void KmerHashTable<I, V>::insert(const char* key, V value) {
  */
 template<class I, class V>
 void KmerHashTable<I, V>::insert(const char* sequence, int keyStart, V value) {
-	values[hash(sequence, keyStart)] = value;
+	setValue(hash(sequence, keyStart), value);
 }
 
 template<class I, class V>
 void KmerHashTable<I, V>::insert(I keyHash, V value) {
-	values[keyHash] = value;
+	setValue(keyHash, value);
 }
 
 /**
@@ -198,11 +358,32 @@ void KmerHashTable<I, V>::wholesaleIncrement(const char* sequence,
 	vector<I> hashList = vector<I>();
 	hash(sequence, firstKmerStart, lastKmerStart, &hashList);
 
-	# pragma omp critical
-	{
-		unsigned int size = hashList.size();
+	// Threads counting other segments update the same table, so each
+	// increment is atomic; no thread waits for another to finish a segment.
+	unsigned int size = hashList.size();
+	if (isCompact) {
+		unordered_map<I, V> localMap;
+		for (unsigned int i = 0; i < size; i++) {
+			addValue(hashList[i], 1, localMap);
+		}
+		addOverflow(localMap);
+	} else if (maxTableSize <= size) {
+		// A table no larger than the segment, e.g. a Markov model, is counted
+		// privately first, so the threads do not contend for its few entries.
+		vector<V> countList(maxTableSize, 0);
 		for (unsigned int i = 0; i < size; i++) {
-			I keyHash = hashList.at(i);
+			countList[hashList[i]]++;
+		}
+		for (I keyHash = 0; keyHash < maxTableSize; keyHash++) {
+			if (countList[keyHash] != 0) {
+				# pragma omp atomic
+				values[keyHash] += countList[keyHash];
+			}
+		}
+	} else {
+		for (unsigned int i = 0; i < size; i++) {
+			I keyHash = hashList[i];
+			# pragma omp atomic
 			values[keyHash]++;
 		}
 	}
@@ -238,7 +419,11 @@ template<class I, class V>
 void KmerHashTable<I, V>::increment(const char* sequence, int keyStart) {
 	// Increment the count of the kmer by one.
 	I index = hash(sequence, keyStart);
-	values[index]++;
+	if (isCompact) {
+		setValue(index, valueAt(index) + 1);
+	} else {
+		values[index]++;
+	}
 
 	// Generate the reverse complement of the kmer.
 	char * rcKmer = new char[k];
@@ -266,7 +451,11 @@ void KmerHashTable<I, V>::increment(const char* sequence, int keyStart) {
 
 	// Update the count of the reverse complement of the kmer by one.
 	I rcIndex = hash(rcKmer, 0);
-	values[rcIndex]++;
+	if (isCompact) {
+		setValue(rcIndex, valueAt(rcIndex) + 1);
+	} else {
+		values[rcIndex]++;
+	}
 
 	// Free memory
 	delete[] rcKmer;
@@ -286,12 +475,12 @@ V KmerHashTable<I, V>::valueOf(const char* key) {
  */
 template<class I, class V>
 V KmerHashTable<I, V>::valueOf(const char* sequence, int keyStart) {
-	return values[hash(sequence, keyStart)];
+	return valueAt(hash(sequence, keyStart));
 }
 
 template<class I, class V>
 V KmerHashTable<I, V>::valueOf(I keyHash) {
-	return values[keyHash];
+	return valueAt(keyHash);
 }
 
 template<class I, class V>
@@ -316,11 +505,45 @@ void KmerHashTable<I, V>::wholesaleValueOf(const char * sequence,
 	int size = hashList.size();
 
 	for (int i = 0; i < size; i++) {
-		(*results)[index] = values[hashList.at(i)];
+		(*results)[index] = valueAt(hashList.at(i));
 		index++;
 	}
 }
 
+/**
+ * The same values read from a packed sequence. The hashes are computed a
+ * block at a time from the 2-bit codes, so no hash list is built. The
+ * k-mers must not cover an unknown base.
+ */
+template<class I, class V>
+void KmerHashTable<I, V>::wholesaleValueOf(const utility::PackedSequence &sequence,
+		int firstKmerStart, int lastKmerStart, vector<V> * results,
+		int resultsStart) {
+
+	auto segmentList = sequence.makeSegments(firstKmerStart, lastKmerStart + k);
+	if (segmentList.size() != 1 || segmentList[0].first != firstKmerStart) {
+		string msg("The k-mers from ");
+		msg.append(utility::Util::int2string(firstKmerStart));
+		msg.append(" to ");
+		msg.append(utility::Util::int2string(lastKmerStart));
+		msg.append(" cover an unknown nucleotide.");
+		throw InvalidInputException(msg);
+	}
+
+	int shift = resultsStart - firstKmerStart;
+	if (isCompact) {
+		sequence.forEachKmer(k, firstKmerStart, lastKmerStart,
+				[this, results, shift](int i, uint64_t h) {
+					(*results)[i + shift] = valueAt(h);
+				});
+	} else {
+		sequence.forEachKmer(k, firstKmerStart, lastKmerStart,
+				[this, results, shift](int i, uint64_t h) {
+					(*results)[i + shift] = values[h];
+				});
+	}
+}
+
 /**
  * This method returns the number of occupied entries in the table.
  * A non-occupied entry has the initial value.
@@ -329,7 +552,7 @@ template<class I, class V>
 I KmerHashTable<I, V>::countNonInitialEntries() {
 	I count = 0;
 	for (I i = 0; i < maxTableSize; i++) {
-		if (values[i] != initialValue) {
+		if (valueAt(i) != initialValue) {
 			count++;
 		}
 	}
@@ -398,13 +621,60 @@ void KmerHashTable<I, V>::printTable(string output) {
 		}
 		// cerr << "Hash: " << hash(keys.at(i), 0) << endl;
 
-		out << " -> " << values[hash(keys.at(i), 0)] << endl;
+		out << " -> " << valueAt(hash(keys.at(i), 0)) << endl;
 	}
 
 	out.close();
 	keys.clear();
 }
 
+/**
+ * Writes the values of the table in binary.
+ * A compact table writes the same values, a block at a time.
+ */
+template<class I, class V>
+void KmerHashTable<I, V>::writeValues(ostream &out) {
+	if (!isCompact) {
+		out.write(reinterpret_cast<const char *>(values), sizeof(V) * maxTableSize);
+		return;
+	}
+
+	const I blockSize = 1 << 20;
+	vector<V> block;
+	block.reserve(blockSize);
+	for (I start = 0; start < maxTableSize; start += blockSize) {
+		I end = start + blockSize < maxTableSize ? start + blockSize : maxTableSize;
+		block.clear();
+		for (I i = start; i < end; i++) {
+			block.push_back(valueAt(i));
+		}
+		out.write(reinterpret_cast<const char *>(block.data()), sizeof(V) * block.size());
+	}
+}
+
+/**
+ * Reads values written by writeValues into the table.
+ * The table must have the same k; the caller checks the state of the stream.
+ */
+template<class I, class V>
+void KmerHashTable<I, V>::readValues(istream &in) {
+	if (!isCompact) {
+		in.read(reinterpret_cast<char *>(values), sizeof(V) * maxTableSize);
+		return;
+	}
+
+	const I blockSize = 1 << 20;
+	vector<V> block(blockSize);
+	for (I start = 0; start < maxTableSize && in; start += blockSize) {
+		I end = start + blockSize < maxTableSize ? start + blockSize : maxTableSize;
+		in.read(reinterpret_cast<char *>(block.data()), sizeof(V) * (end - start));
+		for (I i = start; i < end; i++) {
+			setValue(i, block[i - start]);
+		}
+	}
+	freeze();
+}
+
 template<class I, class V>
 int KmerHashTable<I, V>::getK() {
 	return k;
@@ -420,6 +690,11 @@ const V * KmerHashTable<I, V>::getValues() const {
 	return values;
 }
 
+template<class I, class V>
+bool KmerHashTable<I, V>::getIsCompact() {
+	return isCompact;
+}
+
 /**
  * Call after building the table.
  * A negative value is a likely indication of overflow.
@@ -427,7 +702,7 @@ const V * KmerHashTable<I, V>::getValues() const {
 template<class I, class V>
 void KmerHashTable<I, V>::checkOverflow() {
 	for (I y = 0; y < maxTableSize; y++) {
-		if (values[y] < 0) {
+		if (valueAt(y) < 0) {
 			string msg("A negative value is a likely indication of overflow. ");
 			msg.append(
 					"To the developer, consider larger data type in KmerHashTable.");
@@ -440,8 +715,9 @@ template<class I, class V>
 V KmerHashTable<I, V>::getMaxValue() {
 	V max = 0;
 	for (I y = 0; y < maxTableSize; y++) {
-		if (values[y] > max) {
-			max = values[y];
+		V value = valueAt(y);
+		if (value > max) {
+			max = value;
 		}
 	}
 	return max;
@@ -10,10 +10,15 @@
 
 #include <string>
 #include <vector>
+#include <iostream>
 #include "ITableView.h"
 
 #include <assert.h>
 #include <cstring>
+#include <cstdint>
+#include <unordered_map>
+#include <algorithm>
+#include <utility>
 
 using namespace std;
 using namespace nonltr;
@@ -34,18 +39,47 @@ protected:
 	// The index is the 4ry representation of the key
 	V * values;
 	V initialValue;
+
+	// A compact table keeps 16 bits per key instead of values. A value that
+	// does not fit is kept in overflowMap, and its 16 bits are set to ESCAPE.
+	// A frozen table keeps these values in frozenOverflow, sorted by key,
+	// which threads search without a lock.
+	static const uint16_t ESCAPE = 0xFFFF;
+	bool isCompact;
+	uint16_t * compactValues;
+	unordered_map<I, V> * overflowMap;
+	vector<pair<I, V>> frozenOverflow;
+	bool isFrozen;
+
 	virtual std::pair<I,I> getSegmentLengthAndCount();
 
+	inline V valueAt(I keyHash) {
+		if (!isCompact) {
+			return values[keyHash];
+		}
+		uint16_t value = compactValues[keyHash];
+		return value != ESCAPE ? value : overflowValueAt(keyHash);
+	}
+	void setValue(I, V);
+	V overflowValueAt(I);
+
 private:
 	// [4^0, 4^1, ... , 4^(k-1)]
 	I * bases;
 	I * mMinusOne;
-	void initialize(int, V);
+	void initialize(int, V, bool);
+	void addValue(I, V, unordered_map<I, V> &);
+	void addOverflow(unordered_map<I, V> &);
+	void thaw();
 
 public:
+	// Red makes tables of keys this long or longer compact
+	static const int compactKeyLength = 15;
+
 	/* Methods */
 	KmerHashTable(int);
 	KmerHashTable(int, V);
+	KmerHashTable(int, V, bool);
 
 	virtual ~KmerHashTable();
 
@@ -65,7 +99,10 @@ public:
 	I countNonInitialEntries();
 	void getKeys(vector<const char *>& keys);
 	void printTable(string);
+	void writeValues(ostream &);
+	void readValues(istream &);
 	void checkOverflow();
+	void freeze();
 
 	/*Vritual methods from ITableView*/
 	virtual V valueOf(const char*);
@@ -73,11 +110,14 @@ public:
 	virtual V valueOf(I);
 	virtual void wholesaleValueOf(const char *, int, int, vector<V> *);
 	virtual void wholesaleValueOf(const char *, int, int, vector<V> *, int);
+	virtual void wholesaleValueOf(const utility::PackedSequence &, int, int, vector<V> *, int);
 
 	virtual int getK();
 	virtual I getMaxTableSize();
 	virtual V getMaxValue();
+	// Null for a compact table
 	virtual const V * getValues() const;
+	bool getIsCompact();
 };
 }
 
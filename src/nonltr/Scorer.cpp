@@ -28,7 +28,8 @@ Scorer::~Scorer() {
  */
 void Scorer::score() {
 	const vector<vector<int> *> * segment = chrom->getSegment();
-	const char * segBases = chrom->getBase()->c_str();
+	// The digits are packed once; the table reads the k-mers from the packed bases
+	PackedSequence segBases(*chrom->getBase(), PackedSequence::Alphabet::DIGITS);
 
 	for (int s = 0; s < segment->size(); s++) {
 		int start = segment->at(s)->at(0);
@@ -7,15 +7,18 @@
 
 #include "TableBuilder.h"
 
-TableBuilder::TableBuilder(string dir, int motifSize, int order, int minObs) {
-	genomeDir = dir;
+TableBuilder::TableBuilder(ChromosomeCache * cacheIn, int motifSize, int order,
+		int minObs) {
+	cache = cacheIn;
 	k = motifSize;
 	genomeLength = 0;
 	// kmerTable = new KmerHashTable(k);
 	// kmerTable = new EnrichmentView(k);
 
 	// Whenever you change the template, modify line 50 and 70 and the header file line 35
-	kmerTable = new EnrichmentMarkovView<unsigned long, int>(k, order, minObs);
+	// Tables of large k keep 2 bytes per k-mer; the counts past 16 bits go to a map
+	bool isCompact = k >= KmerHashTable<unsigned long, int>::compactKeyLength;
+	kmerTable = new EnrichmentMarkovView<unsigned long, int>(k, 0, order, minObs, isCompact);
 
 	buildTable();
 }
@@ -25,17 +28,15 @@ TableBuilder::~TableBuilder() {
 }
 
 void TableBuilder::buildTable() {
-	vector<string> * fileList = new vector<string>();
-	Util::readChromList(genomeDir, fileList, "fa");
+	int fileCount = cache->getFileCount();
 
 	# pragma omp parallel for schedule(dynamic) num_threads(Util::CORE_NUM) reduction(+: genomeLength)
-	for (unsigned int i = 0; i < fileList->size(); i++) {
+	for (int i = 0; i < fileCount; i++) {
 		# pragma omp critical
 		{
-			cout << "Counting k-mers in " << fileList->at(i) << " ..." << endl;
+			cout << "Counting k-mers in " << cache->getFile(i) << " ..." << endl;
 		}
-		ChromListMaker * maker = new ChromListMaker(fileList->at(i));
-		const vector<Chromosome *> * chromList = maker->makeChromOneDigitList();
+		const vector<Chromosome *> * chromList = cache->getChromList(i);
 
 		for (unsigned int h = 0; h < chromList->size(); h++) {
 			ChromosomeOneDigit * chrom =
@@ -48,7 +49,7 @@ void TableBuilder::buildTable() {
 			}
 		}
 
-		delete maker;
+		cache->releaseChromList(chromList);
 	}
 	// Check if overflow has occurred
 	kmerTable->checkOverflow();
@@ -62,14 +63,13 @@ void TableBuilder::buildTable() {
 		view->generateProbapilities();
 		view->processTable();
 		maxValue = view->getMaxValue();
+		// Scanning reads the table from many threads
+		view->freeze();
 	} else {
 		throw InvalidStateException(string("Dynamic cast failed."));
 	}
 	cout << "Enrichment view is ready." << endl;
 
-	fileList->clear();
-	delete fileList;
-
 	/* If you would like to see the contents of the table.*/
 	// kmerTable-> printTable();
 }
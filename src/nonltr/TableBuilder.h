@@ -11,7 +11,7 @@
 #include "KmerHashTable.h"
 #include "EnrichmentMarkovView.h"
 #include "ChromosomeOneDigit.h"
-#include "ChromListMaker.h"
+#include "ChromosomeCache.h"
 #include "IChromosome.h"
 
 #include "../utility/Util.h"
@@ -34,10 +34,9 @@ private:
 	int maxValue;
 
 	/**
-	 * Directory including the FASTA files comprising the genome.
-	 * These files must have the
+	 * The chromosomes of the FASTA files comprising the genome.
 	 */
-	string genomeDir;
+	ChromosomeCache * cache;
 
 	/**
 	 * The size of the motif
@@ -56,7 +55,7 @@ private:
 	void updateTable(ChromosomeOneDigit *);
 
 public:
-	TableBuilder(string, int, int, int);
+	TableBuilder(ChromosomeCache *, int, int, int);
 	virtual ~TableBuilder();
 	KmerHashTable<unsigned long,int> * const getKmerTable();
 	void printTable();
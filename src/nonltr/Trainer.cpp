@@ -12,48 +12,63 @@ namespace nonltr {
 // Pass the isCND and the isCON parameters
 
 Trainer::Trainer(string genomeDirIn, int orderIn, int kIn, double sIn,
-		double tIn, string candidateDirIn, int m) :
+		double tIn, string candidateDirIn, int m, ChromosomeCache * cacheIn,
+		bool isFastSmoothingIn) :
 		minObs(m) {
 	candidateDir = candidateDirIn;
 	canPrintCandidates = true;
 	isCND = true;
 	isCON = false;
-	initialize(genomeDirIn, orderIn, kIn, sIn, tIn);
+	initialize(genomeDirIn, orderIn, kIn, sIn, tIn, cacheIn, isFastSmoothingIn);
 }
 
 Trainer::Trainer(string genomeDirIn, int orderIn, int kIn, double sIn,
 		double tIn, string candidateDirIn, bool isCNDIn, string otherDirIn,
-		int m) :
+		int m, ChromosomeCache * cacheIn, bool isFastSmoothingIn) :
 		minObs(m) {
 	candidateDir = candidateDirIn;
 	canPrintCandidates = true;
 	isCND = isCNDIn;
 	isCON = true;
 	otherDir = otherDirIn;
-	initialize(genomeDirIn, orderIn, kIn, sIn, tIn);
+	initialize(genomeDirIn, orderIn, kIn, sIn, tIn, cacheIn, isFastSmoothingIn);
 }
 
 Trainer::Trainer(string genomeDirIn, int orderIn, int kIn, double sIn,
-		double tIn, int m) :
+		double tIn, int m, ChromosomeCache * cacheIn, bool isFastSmoothingIn) :
 		minObs(m) {
 	canPrintCandidates = false;
 	isCND = true;
 	isCON = false;
-	initialize(genomeDirIn, orderIn, kIn, sIn, tIn);
+	initialize(genomeDirIn, orderIn, kIn, sIn, tIn, cacheIn, isFastSmoothingIn);
 }
 
 Trainer::Trainer(string genomeDirIn, int orderIn, int kIn, double sIn,
-		double tIn, bool isCNDIn, string otherDirIn, int m) :
+		double tIn, bool isCNDIn, string otherDirIn, int m,
+		ChromosomeCache * cacheIn, bool isFastSmoothingIn) :
 		minObs(m) {
 	canPrintCandidates = false;
 	isCND = isCNDIn;
 	isCON = true;
 	otherDir = otherDirIn;
-	initialize(genomeDirIn, orderIn, kIn, sIn, tIn);
+	initialize(genomeDirIn, orderIn, kIn, sIn, tIn, cacheIn, isFastSmoothingIn);
+}
+
+Trainer::Trainer(KmerHashTable<unsigned long, int> * tableIn, HMM * hmmIn) :
+		minObs(0) {
+	canPrintCandidates = false;
+	isCND = false;
+	isCON = false;
+	isFastSmoothing = false;
+	cache = nullptr;
+	k = tableIn->getK();
+	builder = nullptr;
+	table = tableIn;
+	hmm = hmmIn;
 }
 
 void Trainer::initialize(string genomeDirIn, int orderIn, int kIn, double sIn,
-		double tIn) {
+		double tIn, ChromosomeCache * cacheIn, bool isFastSmoothingIn) {
 
 	if (isCND == false && isCON == false) {
 		string msg(
@@ -64,9 +79,7 @@ void Trainer::initialize(string genomeDirIn, int orderIn, int kIn, double sIn,
 	}
 
 	genomeDir = genomeDirIn;
-	fileList = new vector<string>();
-	Util::readChromList(genomeDir, fileList, string("fa"));
-	chromCount = fileList->size();
+	cache = cacheIn == nullptr ? new ChromosomeCache(genomeDir) : cacheIn;
 	order = orderIn;
 	k = kIn;
 	s = sIn;
@@ -74,6 +87,7 @@ void Trainer::initialize(string genomeDirIn, int orderIn, int kIn, double sIn,
 	p = 0.0;
 	tDetector = tIn + 0.1;
 	max = -1;
+	isFastSmoothing = isFastSmoothingIn;
 
 	stage1();
 
@@ -81,12 +95,20 @@ void Trainer::initialize(string genomeDirIn, int orderIn, int kIn, double sIn,
 		stage2();
 	}
 	stage3();
+
+	if (cacheIn == nullptr) {
+		delete cache;
+	}
+	cache = nullptr;
 }
 
 Trainer::~Trainer() {
-	fileList->clear();
-	delete fileList;
-	delete builder;
+	// Without a builder, the table was handed to the constructor
+	if (builder == nullptr) {
+		delete table;
+	} else {
+		delete builder;
+	}
 	delete hmm;
 }
 
@@ -96,7 +118,7 @@ Trainer::~Trainer() {
 void Trainer::stage1() {
 	cout << endl << endl;
 	cout << "Stage 1: Building the table ..." << endl;
-	builder = new TableBuilder(genomeDir, k, order, minObs);
+	builder = new TableBuilder(cache, k, order, minObs);
 	table = builder->getKmerTable();
 	genomeLength = builder->getGenomeLength();
 	max = builder->getMaxValue();
@@ -108,17 +130,17 @@ void Trainer::stage2() {
 
 	double effectiveSize = 0.0;
 	double countLessOrEqual = 0.0;
+	int chromCount = cache->getFileCount();
 
 	# pragma omp parallel for schedule(dynamic) num_threads(Util::CORE_NUM) \
 	reduction(+: effectiveSize, countLessOrEqual)
 	for (int i = 0; i < chromCount; i++) {
 		# pragma omp critical
 		{
-			cout << "Calculating the percentage in: " << fileList->at(i) << " ...";
+			cout << "Calculating the percentage in: " << cache->getFile(i) << " ...";
 			cout << endl;
 		}
-		ChromListMaker * maker = new ChromListMaker(fileList->at(i));
-		const vector<Chromosome *> * chromList = maker->makeChromOneDigitList();
+		const vector<Chromosome *> * chromList = cache->getChromList(i);
 
 		for (unsigned int h = 0; h < chromList->size(); h++) {
 			ChromosomeOneDigit * chrom =
@@ -130,7 +152,7 @@ void Trainer::stage2() {
 			countLessOrEqual += scorer->countLessOrEqual(t);
 			delete scorer;
 		}
-		delete maker;
+		cache->releaseChromList(chromList);
 	}
 
 	if (effectiveSize == 0) {
@@ -166,123 +188,133 @@ void Trainer::stage3() {
 	// Initialize the HMM
 	hmm = new HMM(hmmBase, stateCount);
 
+	int chromCount = cache->getFileCount();
+
 	// Start training the models
-	#pragma omp parallel for schedule(dynamic) num_threads(Util::CORE_NUM)
-	for (int i = 0; i < chromCount; i++) {
-		# pragma omp critical
-		{
-			cout << "Training on: " << fileList->at(i) << endl;
-		}
-		// Name of candidates file
-		string path(fileList->at(i));
-		int slashLastIndex = path.find_last_of(Util::fileSeparator);
-		int dotLastIndex = path.find_last_of(".");
-		string nickName = path.substr(slashLastIndex + 1,
-				dotLastIndex - slashLastIndex - 1);
-
-		// May or may not be used
-		string cndFile = candidateDir + Util::fileSeparator + nickName + ".cnd";
-
-		// Work on the other repeats if desired
-		LocationListCollection * otherRegionListCollection;
-		bool isConRepAvailable = false;
-		if (isCON) {
-			string otherFile = otherDir + Util::fileSeparator + nickName
-					+ ".rpt";
-			ifstream f1(otherFile.c_str());
-			if (!f1) {
-				string message = string("Warning: ");
-				message.append(otherFile);
-				message.append(" does not exist. ");
-				message.append(
-						"Repeats of this sequence will not used for training the HMM.");
-				# pragma omp critical
-				{
-					cout << message << endl;
-				}
-			} else {
-				otherRegionListCollection = new LocationListCollection(
-						otherFile);
-				otherRegionListCollection->convertToRedFormat();
-				otherRegionListCollection->trim(k - 1);
+	// Every thread counts the transitions of its files in a model of its own;
+	// the counts are added to the shared model once the thread is done.
+	#pragma omp parallel num_threads(Util::CORE_NUM)
+	{
+		HMM threadHmm(hmmBase, stateCount);
+
+		#pragma omp for schedule(dynamic) nowait
+		for (int i = 0; i < chromCount; i++) {
+			# pragma omp critical
+			{
+				cout << "Training on: " << cache->getFile(i) << endl;
+			}
+			// Name of candidates file
+			string path(cache->getFile(i));
+			int slashLastIndex = path.find_last_of(Util::fileSeparator);
+			int dotLastIndex = path.find_last_of(".");
+			string nickName = path.substr(slashLastIndex + 1,
+					dotLastIndex - slashLastIndex - 1);
+
+			// May or may not be used
+			string cndFile = candidateDir + Util::fileSeparator + nickName + ".cnd";
+
+			// Work on the other repeats if desired
+			LocationListCollection * otherRegionListCollection;
+			bool isConRepAvailable = false;
+			if (isCON) {
+				string otherFile = otherDir + Util::fileSeparator + nickName
+						+ ".rpt";
+				ifstream f1(otherFile.c_str());
+				if (!f1) {
+					string message = string("Warning: ");
+					message.append(otherFile);
+					message.append(" does not exist. ");
+					message.append(
+							"Repeats of this sequence will not used for training the HMM.");
+					# pragma omp critical
+					{
+						cout << message << endl;
+					}
+				} else {
+					otherRegionListCollection = new LocationListCollection(
+							otherFile);
+					otherRegionListCollection->convertToRedFormat();
+					otherRegionListCollection->trim(k - 1);
 
-				isConRepAvailable = true;
+					isConRepAvailable = true;
+				}
+				f1.close();
 			}
-			f1.close();
-		}
 
-		// Read sequences in the file
-		ChromListMaker * maker = new ChromListMaker(fileList->at(i));
-		const vector<Chromosome *> * chromList = maker->makeChromOneDigitList();
+			// Sequences in the file
+			const vector<Chromosome *> * chromList = cache->getChromList(i);
 
-		for (unsigned int h = 0; h < chromList->size(); h++) {
-			ChromosomeOneDigit * chrom =
-					dynamic_cast<ChromosomeOneDigit *>(chromList->at(h));
-			Scorer * scorer = new Scorer(chrom, table);
-			vector<int> * scoreList = scorer->getScores();
-
-			// Detect candidates if desired
-			ChromDetectorMaxima * detector;
-			const vector<ILocation*> * trainingRegionList;
-			bool canDeleteDetector = true;
-			if (isCND) {
-				if (canPrintCandidates) {
-					detector = new ChromDetectorMaxima(s, 10, 0, tDetector, p,
-							s, scoreList, chrom);
-					if (h > 0) {
-						bool canAppend = true;
-						detector->printIndex(cndFile, canAppend);
-					} else {
-						# pragma omp critical
-						{
-							cout << "Printing candidates to: " << cndFile << endl;
+			for (unsigned int h = 0; h < chromList->size(); h++) {
+				ChromosomeOneDigit * chrom =
+						dynamic_cast<ChromosomeOneDigit *>(chromList->at(h));
+				Scorer * scorer = new Scorer(chrom, table);
+				vector<int> * scoreList = scorer->getScores();
+
+				// Detect candidates if desired
+				ChromDetectorMaxima * detector;
+				const vector<ILocation*> * trainingRegionList;
+				bool canDeleteDetector = true;
+				if (isCND) {
+					if (canPrintCandidates) {
+						detector = new ChromDetectorMaxima(s, 10, 0, tDetector, p,
+								s, scoreList, chrom, isFastSmoothing);
+						if (h > 0) {
+							bool canAppend = true;
+							detector->printIndex(cndFile, canAppend);
+						} else {
+							# pragma omp critical
+							{
+								cout << "Printing candidates to: " << cndFile << endl;
+							}
+							detector->printIndex(cndFile);
 						}
-						detector->printIndex(cndFile);
+					} else {
+						detector = new ChromDetectorMaxima(s, 10, 0, tDetector, p,
+								s, scoreList, chrom->getSegment(), isFastSmoothing);
 					}
-				} else {
-					detector = new ChromDetectorMaxima(s, 10, 0, tDetector, p,
-							s, scoreList, chrom->getSegment());
+					trainingRegionList = detector->getRegionList();
 				}
-				trainingRegionList = detector->getRegionList();
-			}
 
-			if (isCON && isConRepAvailable) {
-				LocationList * const locList =
-						otherRegionListCollection->getLocationList(
-								chrom->getHeader());
-				if (isCND) {
-					locList->mergeWithAnotherList(detector->getRegionList());
+				if (isCON && isConRepAvailable) {
+					LocationList * const locList =
+							otherRegionListCollection->getLocationList(
+									chrom->getHeader());
+					if (isCND) {
+						locList->mergeWithAnotherList(detector->getRegionList());
+					}
+					trainingRegionList = locList->getList();
 				}
-				trainingRegionList = locList->getList();
-			}
 
-			// The candidate regions are already copied to the location list
-			if (isCND && isCON && isConRepAvailable) {
-				delete detector;
-				canDeleteDetector = false;
-			}
+				// The candidate regions are already copied to the location list
+				if (isCND && isCON && isConRepAvailable) {
+					delete detector;
+					canDeleteDetector = false;
+				}
+
+				// Train the HMM
+				if (isCND || (isCON && isConRepAvailable)) {
+					scorer->takeLog(t);
+					scoreList = scorer->getScores();
+					threadHmm.train(scoreList, chrom->getSegment(), trainingRegionList);
+				}
 
-			// Train the HMM
-			if (isCND || (isCON && isConRepAvailable)) {
-				scorer->takeLog(t);
-				scoreList = scorer->getScores();
-				# pragma omp critical
-				{
-					hmm->train(scoreList, chrom->getSegment(), trainingRegionList);
+				// Free more memory
+				if (isCND && canDeleteDetector) {
+					delete detector;
 				}
+				delete scorer;
 			}
 
-			// Free more memory
-			if (isCND && canDeleteDetector) {
-				delete detector;
+			if (isCON && isConRepAvailable) {
+				delete otherRegionListCollection;
 			}
-			delete scorer;
+			cache->releaseChromList(chromList);
 		}
 
-		if (isCON && isConRepAvailable) {
-			delete otherRegionListCollection;
+		# pragma omp critical
+		{
+			hmm->addCounts(threadHmm);
 		}
-		delete maker;
 	}
 
 	// Normalize HMM's once training is finished
@@ -19,7 +19,7 @@
 #include "HMM.h"
 #include "ChromDetectorMaxima.h"
 #include "Scorer.h"
-#include "ChromListMaker.h"
+#include "ChromosomeCache.h"
 #include "LocationListCollection.h"
 #include "../utility/Util.h"
 #include "../exception/InvalidStateException.h"
@@ -36,8 +36,8 @@ private:
 	string candidateDir;
 	string otherDir;
 	bool canPrintCandidates;
-	vector<string> * fileList;
-	int chromCount;
+	// The chromosomes of the genome while training; not kept afterwards
+	ChromosomeCache * cache;
 	int order;
 	int k;
 	int max; // Maximum score in the entire genome
@@ -53,6 +53,8 @@ private:
 	HMM * hmm;
 	int isCND;
 	int isCON;
+	// Smooth the scores with box filters instead of the exact Gaussian mask
+	bool isFastSmoothing;
 	// The minimum number of the observed k-mers
 	const int minObs;
 
@@ -62,12 +64,20 @@ private:
 	//void stage4();
 
 public:
-	Trainer(string, int, int, double, double, string, int);
-	Trainer(string, int, int, double, double, string, bool, string, int);
-	Trainer(string, int, int, double, double, int);
-	Trainer(string, int, int, double, double, bool, string, int);
+	// Without a cache of the chromosomes of the genome, the trainer reads them into its own.
+	// The last parameter selects the fast smoother for detecting the candidates.
+	Trainer(string, int, int, double, double, string, int,
+			ChromosomeCache * = nullptr, bool = false);
+	Trainer(string, int, int, double, double, string, bool, string, int,
+			ChromosomeCache * = nullptr, bool = false);
+	Trainer(string, int, int, double, double, int, ChromosomeCache * = nullptr,
+			bool = false);
+	Trainer(string, int, int, double, double, bool, string, int,
+			ChromosomeCache * = nullptr, bool = false);
+	// Takes over a table and a normalized HMM that were trained before
+	Trainer(KmerHashTable<unsigned long, int> *, HMM *);
 
-	void initialize(string, int, int, double, double);
+	void initialize(string, int, int, double, double, ChromosomeCache *, bool);
 	virtual ~Trainer();
 	void printTable(string);
 	void printHmm(string);
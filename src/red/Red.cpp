@@ -27,7 +27,43 @@
 
 Red::Red(std::string _gnm, std::optional<int> _cor, std::optional<int> _k,
          std::optional<int> _ord, std::optional<double> _gau, std::optional<double> _thr,
-         std::optional<int> _min, std::optional<std::string> _cnd)
+         std::optional<int> _min, std::optional<std::string> _cnd,
+         std::optional<std::string> _spillPath, bool _isFastSmoothing)
+{
+    initialize(_gnm, _cor, _k, _ord, _gau, _thr, _min, _cnd, _spillPath, _isFastSmoothing);
+}
+
+Red::Red(std::string _gnm, std::string modelPath, std::optional<int> _cor,
+         std::optional<std::string> _spillPath)
+{
+    assert(std::filesystem::exists(_gnm));
+    assert(_cor.has_value() ? _cor.value() >= 1 : true);
+
+    gnm = _gnm;
+    cor = _cor.has_value() ? _cor.value() : Util::CORE_NUM;
+
+    uint64_t genomeHash = hashGenome();
+    if (loadModel(modelPath, genomeHash))
+    {
+        std::cout << "Red model loaded from " << modelPath << " with the following parameters:" << std::endl
+                  << "\tlen: " << k << std::endl
+                  << "\tord: " << ord << std::endl
+                  << "\tgau: " << gau << std::endl
+                  << "\tthr: " << thr << std::endl
+                  << "\tmin: " << min << std::endl;
+    }
+    else
+    {
+        std::cout << "Red will be trained." << std::endl;
+        initialize(_gnm, _cor, {}, {}, {}, {}, {}, {}, _spillPath, false);
+        saveModel(modelPath, genomeHash);
+    }
+}
+
+void Red::initialize(std::string _gnm, std::optional<int> _cor, std::optional<int> _k,
+                     std::optional<int> _ord, std::optional<double> _gau, std::optional<double> _thr,
+                     std::optional<int> _min, std::optional<std::string> _cnd,
+                     std::optional<std::string> _spillPath, bool _isFastSmoothing)
 {
     assert(std::filesystem::exists(_gnm));
     assert(_cor.has_value() ? _cor.value() >= 1 : true);
@@ -44,6 +80,13 @@ Red::Red(std::string _gnm, std::optional<int> _cor, std::optional<int> _k,
     thr = static_cast<int>(thr) == 1 ? 1.5 : thr;
     min = _min.has_value() ? _min.value() : 3;
 
+    // Every stage below iterates the same encoded chromosomes
+    std::cout << "Reading the genome ..." << std::endl;
+    // Owned here so that the genome, and its scratch file, are released if a stage throws
+    std::unique_ptr<ChromosomeCache> cache = _spillPath.has_value()
+        ? std::make_unique<ChromosomeCache>(gnm, _spillPath.value())
+        : std::make_unique<ChromosomeCache>(gnm);
+
     // Deal with the value of k
     if (_k.has_value())
     {
@@ -51,7 +94,7 @@ Red::Red(std::string _gnm, std::optional<int> _cor, std::optional<int> _k,
     }
     else
     {
-        calcGnmLen();
+        calcGnmLen(*cache);
     }
     if (k > 15)
     {
@@ -95,7 +138,7 @@ Red::Red(std::string _gnm, std::optional<int> _cor, std::optional<int> _k,
     }
     else
     {
-        calcGauWidth();
+        calcGauWidth(*cache);
     }
 
     std::cout << "Red will run with the following parameters:" << std::endl
@@ -110,51 +153,169 @@ Red::Red(std::string _gnm, std::optional<int> _cor, std::optional<int> _k,
     {
         std::cout << "\tcnd: " << _cnd.value() << std::endl;
     }
+    if (_isFastSmoothing)
+    {
+        std::cout << "\tsmo: fast" << std::endl;
+    }
 
     // Train
     if (_cnd.has_value())
     {
-        trainer = new Trainer(gnm, ord, k, gau, thr, _cnd.value(), min);
+        trainer = new Trainer(gnm, ord, k, gau, thr, _cnd.value(), min, cache.get(), _isFastSmoothing);
     }
     else
     {
-        trainer = new Trainer(gnm, ord, k, gau, thr, min);
+        trainer = new Trainer(gnm, ord, k, gau, thr, min, cache.get(), _isFastSmoothing);
     }
 }
 
+Red::Red() : cor(Util::CORE_NUM), trainer(nullptr)
+{
+}
+
 Red::~Red()
 {
     delete trainer;
 }
 
-void Red::calcGnmLen()
+std::unique_ptr<Red> Red::fromModel(std::string modelPath, std::optional<int> _cor)
 {
-    // Calculate the size of the genome
-    long genomeLength = 0;
-
-    std::vector<std::string> *fileList = new std::vector<std::string>();
-    Util::readChromList(gnm, fileList, "fa");
-    std::cout << "Calculating the length, k, of the k-mer ";
-    std::cout << "based on the input genome ... " << std::endl;
+    assert(_cor.has_value() ? _cor.value() >= 1 : true);
 
-    #pragma omp parallel for schedule(dynamic) num_threads(Util::CORE_NUM) reduction(+: genomeLength)
-    for (unsigned int i = 0; i < fileList->size(); i++)
+    std::unique_ptr<Red> r(new Red());
+    r->cor = _cor.has_value() ? _cor.value() : Util::CORE_NUM;
+    if (!r->loadModel(modelPath, {}))
     {
+        std::cerr << "Could not load the Red model " << modelPath << std::endl;
+        throw std::exception();
+    }
+    return r;
+}
 
-        #pragma omp critical
-        {
-            std::cout << "\t" << fileList->at(i) << std::endl;
+uint64_t Red::hashGenome()
+{
+    std::vector<std::string> fileList;
+    Util::readChromList(gnm, &fileList, "fa");
+    std::sort(fileList.begin(), fileList.end(), [](const std::string &a, const std::string &b) {
+        return std::filesystem::path(a).filename() < std::filesystem::path(b).filename();
+    });
+
+    uint64_t hash = 14695981039346656037ULL;
+    auto mix = [&hash](const char *data, std::streamsize len) {
+        for (std::streamsize i = 0; i < len; i++) {
+            hash ^= static_cast<unsigned char>(data[i]);
+            hash *= 1099511628211ULL;
         }
-        ChromListMaker *maker = new ChromListMaker(fileList->at(i));
-        const std::vector<Chromosome *> *chromList = maker->makeChromList();
-        for (unsigned int h = 0; h < chromList->size(); h++)
+    };
+
+    std::vector<char> buffer(1 << 20);
+    for (auto &file : fileList)
+    {
+        std::ifstream in(file, std::ios::binary);
+        uint64_t fileSize = 0;
+        while (in.read(buffer.data(), buffer.size()) || in.gcount() > 0)
         {
-            genomeLength += chromList->at(h)->getEffectiveSize();
+            mix(buffer.data(), in.gcount());
+            fileSize += in.gcount();
         }
-        delete maker;
+        // Keeps the boundaries between files in the hash
+        mix(reinterpret_cast<const char *>(&fileSize), sizeof(fileSize));
     }
-    fileList->clear();
-    delete fileList;
+    return hash;
+}
+
+bool Red::loadModel(std::string modelPath, std::optional<uint64_t> genomeHash)
+{
+    std::ifstream in(modelPath, std::ios::binary);
+    if (!in)
+    {
+        return false;
+    }
+
+    uint32_t version;
+    uint64_t hash;
+    in.read(reinterpret_cast<char *>(&version), sizeof(version));
+    in.read(reinterpret_cast<char *>(&hash), sizeof(hash));
+    if (!in || version != MODEL_VERSION)
+    {
+        std::cout << modelPath << " is not a Red model of this version." << std::endl;
+        return false;
+    }
+    if (genomeHash.has_value() && hash != genomeHash.value())
+    {
+        std::cout << modelPath << " was trained on another genome." << std::endl;
+        return false;
+    }
+
+    in.read(reinterpret_cast<char *>(&k), sizeof(k));
+    in.read(reinterpret_cast<char *>(&ord), sizeof(ord));
+    in.read(reinterpret_cast<char *>(&gau), sizeof(gau));
+    in.read(reinterpret_cast<char *>(&thr), sizeof(thr));
+    in.read(reinterpret_cast<char *>(&min), sizeof(min));
+    if (!in || k < 12 || k > 15)
+    {
+        std::cout << modelPath << " is damaged." << std::endl;
+        return false;
+    }
+
+    HMM *hmm = nullptr;
+    try
+    {
+        hmm = new HMM(in);
+    }
+    catch (...)
+    {
+        std::cout << modelPath << " is damaged." << std::endl;
+        return false;
+    }
+    auto table = new KmerHashTable<unsigned long, int>(k, 0,
+        k >= KmerHashTable<unsigned long, int>::compactKeyLength);
+    table->readValues(in);
+    if (!in)
+    {
+        std::cout << modelPath << " is damaged." << std::endl;
+        delete hmm;
+        delete table;
+        return false;
+    }
+
+    trainer = new Trainer(table, hmm);
+    return true;
+}
+
+void Red::saveModel(std::string modelPath, uint64_t genomeHash)
+{
+    // Written next to the target and renamed, so an interrupted run never leaves a partial model
+    std::string tempPath = modelPath + ".tmp";
+    std::ofstream out(tempPath, std::ios::binary);
+    uint32_t version = MODEL_VERSION;
+    out.write(reinterpret_cast<const char *>(&version), sizeof(version));
+    out.write(reinterpret_cast<const char *>(&genomeHash), sizeof(genomeHash));
+    out.write(reinterpret_cast<const char *>(&k), sizeof(k));
+    out.write(reinterpret_cast<const char *>(&ord), sizeof(ord));
+    out.write(reinterpret_cast<const char *>(&gau), sizeof(gau));
+    out.write(reinterpret_cast<const char *>(&thr), sizeof(thr));
+    out.write(reinterpret_cast<const char *>(&min), sizeof(min));
+    trainer->getHmm()->write(out);
+    trainer->getTable()->writeValues(out);
+    out.close();
+
+    if (!out)
+    {
+        std::cerr << "Could not write the Red model to " << modelPath << std::endl;
+        std::filesystem::remove(tempPath);
+        return;
+    }
+    std::filesystem::rename(tempPath, modelPath);
+    std::cout << "Red model saved to " << modelPath << std::endl;
+}
+
+void Red::calcGnmLen(ChromosomeCache &cache)
+{
+    // Calculate the size of the genome
+    std::cout << "Calculating the length, k, of the k-mer ";
+    std::cout << "based on the input genome ... " << std::endl;
+    long genomeLength = cache.getEffectiveSize();
 
     double temp = log(genomeLength) / log(4.0);
 
@@ -170,37 +331,13 @@ void Red::calcMarkovOrd()
     std::cout << std::endl;
 }
 
-void Red::calcGauWidth()
+void Red::calcGauWidth(ChromosomeCache &cache)
 {
     std::cout << "Calculating GC content ..." << std::endl;
 
     // 1: Count the gc content of the input genome
-    long genomeLength = 0;
-    long genomeGc = 0;
-    std::vector<std::string> *fileList = new std::vector<std::string>();
-    Util::readChromList(gnm, fileList, "fa");
-
-#pragma omp parallel for num_threads(Util::CORE_NUM) schedule(dynamic) reduction(+ \
-                                                                                 : genomeGc, genomeLength)
-    for (unsigned int i = 0; i < fileList->size(); i++)
-    {
-#pragma omp critical
-        {
-            std::cout << "\t" << fileList->at(i) << std::endl;
-        }
-
-        ChromListMaker *maker = new ChromListMaker(fileList->at(i));
-        const std::vector<Chromosome *> *chromList = maker->makeChromList();
-        for (unsigned int h = 0; h < chromList->size(); h++)
-        {
-            genomeGc += chromList->at(h)->getGcContent();
-            genomeLength += chromList->at(h)->getEffectiveSize();
-        }
-
-        delete maker;
-    }
-    fileList->clear();
-    delete fileList;
+    long genomeLength = cache.getEffectiveSize();
+    long genomeGc = cache.getGcContent();
 
     // 2: Calculate the gc content of the input genome
     double gc = 100.00 * genomeGc / genomeLength;
@@ -223,33 +360,64 @@ void Red::printModel(std::string fileName)
     trainer->printHmm(fileName);
 }
 
-// @@@@@@@@@@@ TODO: MAKE IT PARALLEL @@@@@@@@@@@@@@@@@@@@@@@@@
+namespace {
+
+/**
+ * One strand of a sequence scanned with a decoder of its own.
+ * The scanner reads the strand and the HMM, so it is destroyed first.
+ */
+struct StrandScan
+{
+    std::unique_ptr<ChromosomeOneDigit> chrom;
+    std::unique_ptr<HMM> hmm;
+    std::unique_ptr<Scanner> scanner;
+};
+
+}
+
 const std::vector<ILocation*>* Red::predictRepeats(std::string &seq)
 {
-    ChromosomeOneDigit chrom(seq, "temp");
-    
-    HMM *copyHMM = new HMM(*trainer->getHmm());
-
-    // Scan the forward strand
-    Scanner *scanner = new Scanner(copyHMM, k, &chrom,
-                                    trainer->getTable());
-
-    // Scan the reverse complement
-    chrom.makeRC();
-    Scanner *scannerRC = new Scanner(copyHMM, k, &chrom,
-                                        trainer->getTable());
-    scannerRC->makeForwardCoordinates();
-    scanner->mergeWithOtherRegions(scannerRC->getRegionList());
-    delete scannerRC;
-    chrom.makeRC();
-
-    // Scan the reverse
-    chrom.makeR();
-    Scanner *scannerR = new Scanner(copyHMM, k, &chrom,
-                                    trainer->getTable());
-    scannerR->makeForwardCoordinates();
-    scanner->mergeWithOtherRegions(scannerR->getRegionList());
-    delete scannerR;
+    // Forward, reverse complement, and reverse. Every strand is built from the sequence, so the
+    // scans share only the k-mer table, which they read.
+    StrandScan scanList[3];
+    auto scan = [&](int strand) {
+        StrandScan &s = scanList[strand];
+        s.chrom = std::make_unique<ChromosomeOneDigit>(seq, "temp");
+        if (strand == 1) {
+            s.chrom->makeRC();
+        }
+        else if (strand == 2) {
+            s.chrom->makeR();
+        }
+        s.hmm = std::make_unique<HMM>(*trainer->getHmm());
+        s.scanner = std::make_unique<Scanner>(s.hmm.get(), k, s.chrom.get(), trainer->getTable());
+        if (strand != 0) {
+            s.scanner->makeForwardCoordinates();
+        }
+    };
+
+    // Inside a parallel region, e.g., one chromosome per thread, the scans are tasks of that team,
+    // taken by threads that ran out of work; otherwise they get a team of their own.
+    auto scanAll = [&]() {
+        for (int strand = 0; strand < 3; strand++) {
+            #pragma omp task
+            scan(strand);
+        }
+        #pragma omp taskwait
+    };
+    if (omp_in_parallel()) {
+        scanAll();
+    }
+    else {
+        #pragma omp parallel num_threads(std::min(cor, 3))
+        #pragma omp single
+        scanAll();
+    }
+
+    // Merging the lists of the overlapping regions is linear in their count
+    Scanner *scanner = scanList[0].scanner.get();
+    scanner->mergeWithOtherRegions(scanList[1].scanner->getRegionList());
+    scanner->mergeWithOtherRegions(scanList[2].scanner->getRegionList());
 
     auto regionList = scanner->getRegionList();
     std::vector<ILocation*>* r = new std::vector<ILocation*>{regionList->size(), nullptr};
@@ -257,9 +425,6 @@ const std::vector<ILocation*>* Red::predictRepeats(std::string &seq)
         r->at(i) = new Location(* regionList->at(i) );
     }
 
-    delete scanner;  
-    delete copyHMM; 
-
     return r;  
 
 }
@@ -438,65 +603,42 @@ std::vector<int> Red::score(std::string &seq){
     return r;
 }
 
-double Red::calcPercent(std::string &seq) {
-    auto scoreVec = score(seq);
-    double count = 0.0;
-    for (auto x : scoreVec) {
-        if (x != 0) {
-            count++;
-        }
-    }
-
-    return count / scoreVec.size();
+RedScoreTrack Red::scoreTrack(std::string &seq){
+    return RedScoreTrack(score(seq));
+}
 
+double Red::calcPercent(std::string &seq) {
+    auto track = scoreTrack(seq);
+    return track.calcPercent(0, track.getLength());
 }
 
 int Red::calcMedianScore(std::string &seq) {
-    int r;
-    auto scoreVec = score(seq);
-    std::vector<int> noZeroVec;
-    for (auto x : scoreVec) {
-        if (x != 0) {
-            noZeroVec.push_back(x);
-        }
-    }
-
-    int middle = noZeroVec.size() / 2;
-    if (noZeroVec.size() % 2 == 1) {
-        std::nth_element(noZeroVec.begin(), noZeroVec.begin() + middle, noZeroVec.end());
-        r = noZeroVec.at(noZeroVec.size() / 2);
-    }
-    else {
-        std::nth_element(noZeroVec.begin(), noZeroVec.begin() + middle, noZeroVec.end());
-        std::nth_element(noZeroVec.begin(), noZeroVec.begin() + middle - 1, noZeroVec.end());
-        r = static_cast<int> ((noZeroVec.at(middle) + noZeroVec.at(middle - 1)) / 2.0);
-    }
-    return r;
+    auto track = scoreTrack(seq);
+    return static_cast<int>(track.calcMedian(0, track.getLength()));
 }
 
 double Red::calcMeanScore(std::string &seq, bool withZero) {
-    double r;
-    auto scoreVec = score(seq);
-    auto *scorePtr = &scoreVec;
-    int sum = 0;
-    std::vector<int> noZeroVec;
-    if (withZero == false) {
-        for (auto x : scoreVec) {
-            if (x != 0) {
-                noZeroVec.push_back(x);
-            }
-        }       
-        scorePtr = &noZeroVec;
-    }
-    
-    for (auto x : *scorePtr) {
-        sum += x;
-    }
-    r = sum / double(scorePtr->size());
-    return r;
+    auto track = scoreTrack(seq);
+    return track.calcMean(0, track.getLength(), withZero);
 }
 
 
 int Red::getK(){
     return k;
 }
+
+long long Red::getTableMemory(){
+    return calcTableMemory(k);
+}
+
+long long Red::estimateTableMemory(long long genomeLength){
+    // The k calcGnmLen recommends, within the bounds initialize enforces
+    int estimatedK = floor(log(genomeLength) / log(4.0));
+    estimatedK = std::max(12, std::min(15, estimatedK));
+    return calcTableMemory(estimatedK);
+}
+
+long long Red::calcTableMemory(int keyLength){
+    bool isCompact = keyLength >= KmerHashTable<unsigned long, int>::compactKeyLength;
+    return (1LL << (2 * keyLength)) * (isCompact ? sizeof(uint16_t) : sizeof(int));
+}
@@ -30,6 +30,11 @@
 #include <cmath>
 #include <iostream>
 #include <vector>
+#include <fstream>
+#include <cstdint>
+#include <memory>
+#include <algorithm>
+#include <omp.h>
 
 #include "../utility/Util.h"
 #include "../utility/ILocation.h"
@@ -38,6 +43,8 @@
 #include "../nonltr/Trainer.h"
 #include "../nonltr/Scanner.h"
 #include "../nonltr/ChromosomeOneDigit.h"
+#include "../nonltr/ChromosomeCache.h"
+#include "RedScoreTrack.h"
 
 class Red
 {
@@ -53,23 +60,69 @@ private:
 
     Trainer *trainer;
 
+    // Increase whenever the layout of the model file changes
+    static const uint32_t MODEL_VERSION = 1;
+
 
     // Methods
-    void calcGnmLen();
+    Red();
+    void initialize(std::string _gnm, std::optional<int> _cor, std::optional<int> _k,
+        std::optional<int> _ord, std::optional<double> _gau,
+        std::optional<double> _thr, std::optional<int> _min,
+        std::optional<std::string> _cnd, std::optional<std::string> _spillPath,
+        bool _isFastSmoothing);
+    void calcGnmLen(ChromosomeCache &cache);
     void calcMarkovOrd();
-    void calcGauWidth();
+    void calcGauWidth(ChromosomeCache &cache);
+    static long long calcTableMemory(int keyLength);
+
+    /**
+     * FNV-1a hash of the contents of the genome's fasta files, in file name order
+     */
+    uint64_t hashGenome();
+
+    /**
+     * Returns false, leaving Red untrained, if the file is missing, of another version,
+     * from another genome, or truncated. Without a genomeHash, a model of any genome is accepted.
+     */
+    bool loadModel(std::string modelPath, std::optional<uint64_t> genomeHash);
+    void saveModel(std::string modelPath, uint64_t genomeHash);
 
 public:
     // Constructor
 
+    /**
+     * The genome is read once for all of the training stages and kept in memory, unless
+     * _spillPath is given; then it is kept in that scratch file, which is removed after training.
+     * _isFastSmoothing smooths the scores of the candidate detector with box filters,
+     * which approximate the Gaussian mask in constant time per base.
+     */
     Red(std::string _gnm, std::optional<int> _cor = {}, std::optional<int> _k = {},
         std::optional<int> _ord = {}, std::optional<double> _gau = {},
         std::optional<double> _thr = {}, std::optional<int> _min = {},
-        std::optional<std::string> _cnd = {});
+        std::optional<std::string> _cnd = {}, std::optional<std::string> _spillPath = {},
+        bool _isFastSmoothing = false);
+
+    /**
+     * Reuses the model saved at modelPath if it was trained on the same genome.
+     * Otherwise, trains with the default parameters and saves the model to modelPath.
+     */
+    Red(std::string _gnm, std::string modelPath, std::optional<int> _cor = {},
+        std::optional<std::string> _spillPath = {});
     ~Red();
 
+    /**
+     * Loads a saved model without its genome, for scoring sequences held in memory.
+     * Throws if the model can not be read. scan needs the genome and is not available.
+     */
+    static std::unique_ptr<Red> fromModel(std::string modelPath, std::optional<int> _cor = {});
+
     // Getter and Setters
     int getK();
+    // Bytes held by the k-mer table; tables of large k keep 2 bytes per k-mer
+    long long getTableMemory();
+    // Bytes the table would hold if Red were trained with the default k on a genome of this length
+    static long long estimateTableMemory(long long genomeLength);
 
     // Methods
     /**
@@ -96,6 +149,11 @@ public:
      */
     std::vector<int> score(std::string &seq);
 
+    /**
+     * Score a seq once, for the interval queries of many regions of it
+     */
+    RedScoreTrack scoreTrack(std::string &seq);
+
     /**
      * Percentage of count of non-zero scores over total count of scores
      * Tells the repetitiveness of a sequence  
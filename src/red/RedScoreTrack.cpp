@@ -0,0 +1,130 @@
+/*
+ * LtrDetector v2.0 annotates LTR retro-transposons in a genome.
+ *
+ * RedScoreTrack
+ *
+ *  Created on: Oct 17, 2026
+ * Reviewer:
+ *   Purpose:
+ *
+ *
+ * Academic use: Affero General Public License version 1.
+ *
+ * Any restrictions to use for-profit or non-academics: Alternative commercial license is needed.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Please contact Dr. Hani Z. Girgis (hzgirgis@buffalo.edu) if you need more information.
+ *
+ * Copyright (C) 2022 by the authors.
+ */
+
+#include "RedScoreTrack.h"
+
+RedScoreTrack::RedScoreTrack(std::vector<int> &&_scoreVec) : scoreVec(std::move(_scoreVec))
+{
+    int blockCount = scoreVec.size() / BLOCK + 1;
+    sumVec.reserve(blockCount);
+    countVec.reserve(blockCount);
+
+    long long sum = 0;
+    int count = 0;
+    for (int i = 0; i < scoreVec.size(); i++) {
+        if (i % BLOCK == 0) {
+            sumVec.push_back(sum);
+            countVec.push_back(count);
+        }
+        sum += scoreVec[i];
+        if (scoreVec[i] != 0) {
+            count++;
+        }
+    }
+    if (scoreVec.size() % BLOCK == 0) {
+        sumVec.push_back(sum);
+        countVec.push_back(count);
+    }
+}
+
+int RedScoreTrack::getLength() const {
+    return scoreVec.size();
+}
+
+int RedScoreTrack::at(int i) const {
+    return scoreVec[i];
+}
+
+long long RedScoreTrack::sumBefore(int i) const {
+    int block = i / BLOCK;
+    long long r = sumVec[block];
+    for (int j = block * BLOCK; j < i; j++) {
+        r += scoreVec[j];
+    }
+    return r;
+}
+
+int RedScoreTrack::countBefore(int i) const {
+    int block = i / BLOCK;
+    int r = countVec[block];
+    for (int j = block * BLOCK; j < i; j++) {
+        if (scoreVec[j] != 0) {
+            r++;
+        }
+    }
+    return r;
+}
+
+long long RedScoreTrack::calcSum(int start, int end) const {
+    assert(start >= 0 && start <= end && end <= getLength());
+    return sumBefore(end) - sumBefore(start);
+}
+
+int RedScoreTrack::countNonZero(int start, int end) const {
+    assert(start >= 0 && start <= end && end <= getLength());
+    return countBefore(end) - countBefore(start);
+}
+
+double RedScoreTrack::calcMean(int start, int end, bool withZero) const {
+    int size = withZero ? end - start : countNonZero(start, end);
+    return calcSum(start, end) / double(size);
+}
+
+double RedScoreTrack::calcPercent(int start, int end) const {
+    return countNonZero(start, end) / double(end - start);
+}
+
+double RedScoreTrack::calcPercent(const std::vector<std::pair<int, int>> &rangeVec) const {
+    double count = 0.0;
+    int size = 0;
+    for (auto &range : rangeVec) {
+        count += countNonZero(range.first, range.second);
+        size += range.second - range.first;
+    }
+    return count / size;
+}
+
+double RedScoreTrack::calcMedian(int start, int end) const {
+    assert(start >= 0 && start <= end && end <= getLength());
+    std::vector<int> noZeroVec;
+    noZeroVec.reserve(countNonZero(start, end));
+    for (int i = start; i < end; i++) {
+        if (scoreVec[i] != 0) {
+            noZeroVec.push_back(scoreVec[i]);
+        }
+    }
+
+    double r = 0.0;
+    if (noZeroVec.size() > 0) {
+        int middle = noZeroVec.size() / 2;
+        std::nth_element(noZeroVec.begin(), noZeroVec.begin() + middle, noZeroVec.end());
+        if (noZeroVec.size() % 2 == 1) {
+            r = noZeroVec[middle];
+        }
+        else {
+            // The lower middle is the largest score left of the upper one
+            int lower = *std::max_element(noZeroVec.begin(), noZeroVec.begin() + middle);
+            r = (noZeroVec[middle] + lower) / 2.0;
+        }
+    }
+    return r;
+}
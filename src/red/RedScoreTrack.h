@@ -0,0 +1,82 @@
+/*
+ * LtrDetector v2.0 annotates LTR retro-transposons in a genome.
+ *
+ * RedScoreTrack
+ *
+ *  Created on: Oct 17, 2026
+ * Reviewer:
+ *   Purpose: Red's scores of a whole sequence, indexed so that the sum, the count of
+ *            non-zero scores, and the mean and percentage derived from them are answered
+ *            for any interval without rescoring it.
+ *
+ * Academic use: Affero General Public License version 1.
+ *
+ * Any restrictions to use for-profit or non-academics: Alternative commercial license is needed.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Please contact Dr. Hani Z. Girgis (hzgirgis@buffalo.edu) if you need more information.
+ *
+ * Copyright (C) 2022 by the authors.
+ */
+
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <assert.h>
+
+/**
+ * The prefix sums and the prefix counts of non-zero scores are sampled every BLOCK bases,
+ * a long long and an int per block, so the index adds under half a byte per base to the
+ * scores. A query adds the samples at its ends to at most BLOCK - 1 scores past each.
+ * Intervals are half open, [start, end).
+ */
+class RedScoreTrack
+{
+private:
+    // Variables
+    static const int BLOCK = 64;
+
+    std::vector<int> scoreVec;
+
+    // Sum and count of non-zero scores before the first base of each block
+    std::vector<long long> sumVec;
+    std::vector<int> countVec;
+
+    // Methods
+    long long sumBefore(int i) const;
+    int countBefore(int i) const;
+
+public:
+
+    // Constructor
+    RedScoreTrack(std::vector<int> &&_scoreVec);
+
+    // Getter
+    int getLength() const;
+    int at(int i) const;
+
+    // Methods
+    long long calcSum(int start, int end) const;
+    int countNonZero(int start, int end) const;
+
+    /**
+     * If false is passed to withZero, then the mean is calculated without including 0's
+     */
+    double calcMean(int start, int end, bool withZero = true) const;
+
+    /**
+     * Percentage of count of non-zero scores over total count of scores
+     */
+    double calcPercent(int start, int end) const;
+    double calcPercent(const std::vector<std::pair<int, int>> &rangeVec) const;
+
+    /**
+     * Median of the non-zero scores, or 0 if there are none; the mean of the middle two
+     * if there is an even number. Selects from a copy of the interval's scores.
+     */
+    double calcMedian(int start, int end) const;
+};
@@ -0,0 +1,74 @@
+/*
+ * PackedSequenceTest.cpp
+ *
+ * Checks that every hashKmers kernel the CPU supports gives the hashes
+ * KmerIterator rolls, for k = 1 to 32, at random offsets, with the identity
+ * digit map and with the map of KmerHistogram. Returns non-zero on failure.
+ */
+
+#include "../utility/PackedSequence.h"
+
+#include <vector>
+#include <string>
+#include <random>
+#include <iostream>
+
+using namespace utility;
+
+// The digit map of KmerHistogram: A, C, G, T
+const uint8_t HISTOGRAM_MAP[4] = { 2, 0, 3, 1 };
+
+bool check(const PackedSequence &seq, int k, int first, int count, const uint8_t *digitMap) {
+    std::vector<uint64_t> hashList(count);
+    seq.hashKmers(k, first, count, hashList.data(), digitMap);
+
+    PackedSequence::KmerIterator itr(seq, k, first, digitMap);
+    for (int i = 0; i < count; i++) {
+        if (i > 0) {
+            ++itr;
+        }
+        if (*itr != hashList[i]) {
+            std::cout << "FAIL k = " << k << " first = " << first << " position = " << first + i << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    std::mt19937 rng(17);
+
+    // Long enough for several blocks of HASH_BLOCK hashes
+    std::string bases(5000, 'A');
+    for (auto &c : bases) {
+        c = "ACGT"[rng() % 4];
+    }
+    PackedSequence seq(bases);
+
+    bool isPass = true;
+    for (auto kernel : {PackedSequence::HashKernel::SCALAR, PackedSequence::HashKernel::AVX2,
+                        PackedSequence::HashKernel::AVX512}) {
+        PackedSequence::setHashKernel(kernel);
+        if (PackedSequence::getHashKernel() != kernel) {
+            std::cout << "SKIP kernel " << static_cast<int>(kernel) << ": not supported by this CPU" << std::endl;
+            continue;
+        }
+
+        bool isKernelPass = true;
+        for (const uint8_t *digitMap : {PackedSequence::IDENTITY_MAP, HISTOGRAM_MAP}) {
+            for (int k = 1; k <= 32; k++) {
+                for (int r = 0; r < 20; r++) {
+                    // Random offsets start k-mers anywhere in a word; long counts cross blocks
+                    int first = rng() % (seq.size() - k + 1);
+                    int count = rng() % (seq.size() - k - first + 2);
+                    isKernelPass &= check(seq, k, first, count, digitMap);
+                }
+                isKernelPass &= check(seq, k, 0, seq.size() - k + 1, digitMap);
+            }
+        }
+        std::cout << (isKernelPass ? "PASS" : "FAIL") << " kernel " << static_cast<int>(kernel) << std::endl;
+        isPass &= isKernelPass;
+    }
+
+    return isPass ? 0 : 1;
+}
@@ -0,0 +1,89 @@
+/*
+ * SmoothTest.cpp
+ *
+ * Checks that the fast smoother of DetectorMaxima stays within a tolerance of
+ * the Gaussian mask on scores shaped like Red's: runs of low scores broken by
+ * repeats of high scores. Returns non-zero on failure.
+ */
+
+#include "../nonltr/DetectorMaxima.h"
+
+#include <vector>
+#include <random>
+#include <cmath>
+#include <iostream>
+
+using namespace nonltr;
+
+// Maximum difference allowed, as a fraction of the largest score in the segment
+const double TOLERANCE = 0.05;
+
+std::vector<int> makeScores(int len, std::mt19937 &rng) {
+    std::vector<int> scoreVec;
+    while (scoreVec.size() < len) {
+        int runLen = 1 + rng() % 300;
+        int level = rng() % 4 == 0 ? 5 + rng() % 60 : rng() % 3;
+        for (int i = 0; i < runLen && scoreVec.size() < len; i++) {
+            scoreVec.push_back(rng() % 8 == 0 ? rng() % 70 : level);
+        }
+    }
+    return scoreVec;
+}
+
+bool check(std::vector<int> &scoreVec, int segStart, int segEnd, double s) {
+    std::vector<double> exactVec;
+    std::vector<double> fastVec;
+    DetectorMaxima::smoothScores(&scoreVec, segStart, segEnd, s, false, &exactVec);
+    DetectorMaxima::smoothScores(&scoreVec, segStart, segEnd, s, true, &fastVec);
+
+    if (exactVec.size() != fastVec.size() || exactVec.size() != segEnd - segStart + 1) {
+        std::cout << "Size mismatch for s = " << s << std::endl;
+        return false;
+    }
+
+    int maxScore = 1;
+    for (int i = segStart; i <= segEnd; i++) {
+        maxScore = std::max(maxScore, scoreVec[i]);
+    }
+
+    double maxDiff = 0.0;
+    for (int i = 0; i < exactVec.size(); i++) {
+        maxDiff = std::max(maxDiff, std::abs(exactVec[i] - fastVec[i]));
+    }
+
+    bool isPass = maxDiff <= TOLERANCE * maxScore;
+    std::cout << (isPass ? "PASS" : "FAIL") << " s = " << s << " segment = " << segStart
+              << "-" << segEnd << " max difference = " << maxDiff << " max score = " << maxScore
+              << std::endl;
+    return isPass;
+}
+
+int main() {
+    std::mt19937 rng(13);
+    bool isPass = true;
+
+    std::vector<int> scoreVec = makeScores(200000, rng);
+    for (double s : {5.0, 20.0, 30.0, 40.0, 100.0}) {
+        // Whole segments and segments in the middle, so both edges are renormalized
+        isPass &= check(scoreVec, 0, scoreVec.size() - 1, s);
+        isPass &= check(scoreVec, 1234, 150000, s);
+        // Shorter than the mask
+        isPass &= check(scoreVec, 5000, 5000 + s, s);
+    }
+
+    // Renormalization keeps a constant a constant up to the edges
+    std::vector<int> constVec(1000, 7);
+    for (double s : {20.0, 40.0}) {
+        std::vector<double> fastVec;
+        DetectorMaxima::smoothScores(&constVec, 10, 900, s, true, &fastVec);
+        for (double x : fastVec) {
+            if (std::abs(x - 7) > 1e-12) {
+                std::cout << "FAIL constant scores with s = " << s << std::endl;
+                isPass = false;
+                break;
+            }
+        }
+    }
+
+    return isPass ? 0 : 1;
+}
@@ -0,0 +1,334 @@
+/*
+ * PackedSequence.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "PackedSequence.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define PACKED_SEQUENCE_X86
+#endif
+
+namespace utility {
+
+const uint8_t PackedSequence::IDENTITY_MAP[4] = { 0, 1, 2, 3 };
+
+PackedSequence::PackedSequence(const std::string &seq, Alphabet alphabet) :
+		PackedSequence(seq.c_str(), seq.size(), alphabet) {
+}
+
+PackedSequence::PackedSequence(const char *seq, int lengthIn, Alphabet alphabet) :
+		length(lengthIn), codeList((lengthIn + 31) / 32, 0), unknownList(
+				(lengthIn + 63) / 64, 0) {
+	assert(lengthIn >= 0);
+	pack(seq, alphabet);
+}
+
+namespace {
+// The code of a base and whether it is known
+inline bool encode(char c, PackedSequence::Alphabet alphabet, uint64_t &code) {
+	if (alphabet == PackedSequence::Alphabet::DIGITS) {
+		code = static_cast<uint8_t>(c);
+		return code <= 3;
+	}
+	switch (c) {
+	case 'A':
+		code = 0;
+		return true;
+	case 'C':
+		code = 1;
+		return true;
+	case 'G':
+		code = 2;
+		return true;
+	case 'T':
+		code = 3;
+		return true;
+	default:
+		return false;
+	}
+}
+}
+
+/**
+ * 16 bases at a time with SSE2: the codes are found by byte compares and then
+ * folded into 32 bits by shifting pairs of lanes together; the unknown bases
+ * come from the byte mask. The tail is packed one base at a time.
+ */
+void PackedSequence::pack(const char *seq, Alphabet alphabet) {
+	int i = 0;
+
+#if defined(__SSE2__)
+	const __m128i a = _mm_set1_epi8('A');
+	const __m128i c = _mm_set1_epi8('C');
+	const __m128i g = _mm_set1_epi8('G');
+	const __m128i t = _mm_set1_epi8('T');
+	const __m128i one = _mm_set1_epi8(1);
+	const __m128i two = _mm_set1_epi8(2);
+	const __m128i three = _mm_set1_epi8(3);
+	const __m128i low8 = _mm_set1_epi16(0x00FF);
+	const __m128i low16 = _mm_set1_epi32(0x0000FFFF);
+	const __m128i low32 = _mm_set_epi32(0, -1, 0, -1);
+
+	for (; i + 16 <= length; i += 16) {
+		__m128i bases = _mm_loadu_si128(reinterpret_cast<const __m128i*>(seq + i));
+		__m128i codes;
+		__m128i known;
+		if (alphabet == Alphabet::DIGITS) {
+			known = _mm_cmpeq_epi8(_mm_min_epu8(bases, three), bases);
+			codes = _mm_and_si128(bases, known);
+		} else {
+			__m128i isA = _mm_cmpeq_epi8(bases, a);
+			__m128i isC = _mm_cmpeq_epi8(bases, c);
+			__m128i isG = _mm_cmpeq_epi8(bases, g);
+			__m128i isT = _mm_cmpeq_epi8(bases, t);
+			known = _mm_or_si128(_mm_or_si128(isA, isC), _mm_or_si128(isG, isT));
+			codes = _mm_or_si128(
+					_mm_or_si128(_mm_and_si128(isC, one), _mm_and_si128(isG, two)),
+					_mm_and_si128(isT, three));
+		}
+
+		// 16 x 2 bits -> 8 x 4 bits -> 4 x 8 bits -> 2 x 16 bits
+		codes = _mm_and_si128(_mm_or_si128(codes, _mm_srli_epi16(codes, 6)), low8);
+		codes = _mm_and_si128(_mm_or_si128(codes, _mm_srli_epi32(codes, 12)), low16);
+		codes = _mm_and_si128(_mm_or_si128(codes, _mm_srli_epi64(codes, 24)), low32);
+		uint64_t packed = static_cast<uint64_t>(_mm_extract_epi16(codes, 0))
+				| (static_cast<uint64_t>(_mm_extract_epi16(codes, 4)) << 16);
+		codeList[i >> 5] |= packed << ((i & 31) << 1);
+
+		uint64_t unknown = ~static_cast<uint64_t>(_mm_movemask_epi8(known)) & 0xFFFF;
+		unknownList[i >> 6] |= unknown << (i & 63);
+	}
+#endif
+
+	for (; i < length; i++) {
+		uint64_t code = 0;
+		if (encode(seq[i], alphabet, code)) {
+			codeList[i >> 5] |= code << ((i & 31) << 1);
+		} else {
+			unknownList[i >> 6] |= 1ULL << (i & 63);
+		}
+	}
+}
+
+int PackedSequence::size() const {
+	return length;
+}
+
+std::vector<std::pair<int, int> > PackedSequence::makeSegments(int start,
+		int end) const {
+	assert(start >= 0 && start <= end && end <= length);
+
+	std::vector<std::pair<int, int> > segmentList;
+	int i = start;
+	while (i < end) {
+		// Skip a run of unknown bases, then take a run of known ones,
+		// 64 bases at a time where the mask word is uniform
+		while (i < end && isUnknown(i)) {
+			if ((i & 63) == 0 && i + 64 <= end && unknownList[i >> 6] == ~0ULL) {
+				i += 64;
+			} else {
+				i++;
+			}
+		}
+		int segStart = i;
+		while (i < end && !isUnknown(i)) {
+			if ((i & 63) == 0 && i + 64 <= end && unknownList[i >> 6] == 0) {
+				i += 64;
+			} else {
+				i++;
+			}
+		}
+		if (i > segStart) {
+			segmentList.push_back(std::make_pair(segStart, i - 1));
+		}
+	}
+	return segmentList;
+}
+
+std::string PackedSequence::toString(int start, int end) const {
+	assert(start >= 0 && start <= end && end <= length);
+
+	std::string r(end - start, 'N');
+	for (int i = start; i < end; i++) {
+		if (!isUnknown(i)) {
+			r[i - start] = "ACGT"[codeAt(i)];
+		}
+	}
+	return r;
+}
+
+
+namespace {
+/**
+ * The k-mer hashes of the 32 bases of a tile, read from the tile's word and
+ * the next one. Both words hold their bases first-most-significant, so the
+ * k-mer at offset o is the top 2k bits of (word << 2o) | (next >> (64 - 2o)).
+ * The offsets are independent, which lets the vector kernels take 4 or 8
+ * at once with variable shifts.
+ */
+typedef void (*TileKernel)(uint64_t, uint64_t, int, uint64_t*);
+
+void hashTileScalar(uint64_t word, uint64_t next, int k, uint64_t *hashList) {
+	int right = 64 - 2 * k;
+	hashList[0] = word >> right;
+	for (int o = 1; o < 32; o++) {
+		hashList[o] = ((word << (2 * o)) | (next >> (64 - 2 * o))) >> right;
+	}
+}
+
+#ifdef PACKED_SEQUENCE_X86
+__attribute__((target("avx2")))
+void hashTileAvx2(uint64_t word, uint64_t next, int k, uint64_t *hashList) {
+	const __m256i wordList = _mm256_set1_epi64x(word);
+	const __m256i nextList = _mm256_set1_epi64x(next);
+	const __m256i sixtyFour = _mm256_set1_epi64x(64);
+	const __m256i step = _mm256_set1_epi64x(8);
+	const __m128i right = _mm_cvtsi32_si128(64 - 2 * k);
+	// Shifts of 64 give 0, which is what offset 0 needs from the next word
+	__m256i left = _mm256_setr_epi64x(0, 2, 4, 6);
+	for (int o = 0; o < 32; o += 4) {
+		__m256i hash = _mm256_or_si256(_mm256_sllv_epi64(wordList, left),
+				_mm256_srlv_epi64(nextList, _mm256_sub_epi64(sixtyFour, left)));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(hashList + o),
+				_mm256_srl_epi64(hash, right));
+		left = _mm256_add_epi64(left, step);
+	}
+}
+
+__attribute__((target("avx512f")))
+void hashTileAvx512(uint64_t word, uint64_t next, int k, uint64_t *hashList) {
+	const __m512i wordList = _mm512_set1_epi64(word);
+	const __m512i nextList = _mm512_set1_epi64(next);
+	const __m512i sixtyFour = _mm512_set1_epi64(64);
+	const __m512i step = _mm512_set1_epi64(16);
+	const __m128i right = _mm_cvtsi32_si128(64 - 2 * k);
+	__m512i left = _mm512_setr_epi64(0, 2, 4, 6, 8, 10, 12, 14);
+	for (int o = 0; o < 32; o += 8) {
+		__m512i hash = _mm512_or_si512(_mm512_sllv_epi64(wordList, left),
+				_mm512_srlv_epi64(nextList, _mm512_sub_epi64(sixtyFour, left)));
+		_mm512_storeu_si512(hashList + o, _mm512_srl_epi64(hash, right));
+		left = _mm512_add_epi64(left, step);
+	}
+}
+#endif
+
+/**
+ * Four bases of a byte, mapped and turned first-most-significant. The table
+ * of the last digit map a thread used is kept, since callers hash block after
+ * block with the same map.
+ */
+const uint8_t *getByteMap(const uint8_t *digitMap) {
+	thread_local uint32_t key = ~0u;
+	thread_local uint8_t byteMap[256];
+
+	uint32_t mapKey = digitMap[0] | (digitMap[1] << 8) | (digitMap[2] << 16) | (digitMap[3] << 24);
+	if (mapKey != key) {
+		for (int b = 0; b < 256; b++) {
+			byteMap[b] = (digitMap[b & 3] << 6) | (digitMap[(b >> 2) & 3] << 4)
+					| (digitMap[(b >> 4) & 3] << 2) | digitMap[(b >> 6) & 3];
+		}
+		key = mapKey;
+	}
+	return byteMap;
+}
+
+bool isSupported(PackedSequence::HashKernel kernel) {
+#ifdef PACKED_SEQUENCE_X86
+	switch (kernel) {
+	case PackedSequence::HashKernel::AVX512:
+		return __builtin_cpu_supports("avx512f");
+	case PackedSequence::HashKernel::AVX2:
+		return __builtin_cpu_supports("avx2");
+	default:
+		return true;
+	}
+#else
+	return kernel == PackedSequence::HashKernel::SCALAR;
+#endif
+}
+
+PackedSequence::HashKernel &currentKernel() {
+	static PackedSequence::HashKernel kernel =
+			isSupported(PackedSequence::HashKernel::AVX512) ?
+					PackedSequence::HashKernel::AVX512 :
+			isSupported(PackedSequence::HashKernel::AVX2) ?
+					PackedSequence::HashKernel::AVX2 :
+					PackedSequence::HashKernel::SCALAR;
+	return kernel;
+}
+
+TileKernel getTileKernel() {
+#ifdef PACKED_SEQUENCE_X86
+	switch (currentKernel()) {
+	case PackedSequence::HashKernel::AVX512:
+		return hashTileAvx512;
+	case PackedSequence::HashKernel::AVX2:
+		return hashTileAvx2;
+	default:
+		break;
+	}
+#endif
+	return hashTileScalar;
+}
+}
+
+PackedSequence::HashKernel PackedSequence::getHashKernel() {
+	return currentKernel();
+}
+
+void PackedSequence::setHashKernel(HashKernel kernel) {
+	if (isSupported(kernel)) {
+		currentKernel() = kernel;
+	}
+}
+
+void PackedSequence::hashKmers(int k, int first, int count,
+		uint64_t *hashList, const uint8_t *digitMap) const {
+	assert(k >= 1 && k <= 32);
+	assert(first >= 0 && count >= 0 && first + count - 1 + k <= length);
+	if (count == 0) {
+		return;
+	}
+
+	const uint8_t *byteMap = getByteMap(digitMap);
+	auto makeWord = [&](int w) -> uint64_t {
+		if (w >= static_cast<int>(codeList.size())) {
+			return 0;
+		}
+		uint64_t raw = codeList[w];
+		uint64_t word = 0;
+		for (int b = 0; b < 8; b++) {
+			word |= static_cast<uint64_t>(byteMap[(raw >> (8 * b)) & 0xFF]) << (8 * (7 - b));
+		}
+		return word;
+	};
+
+	TileKernel kernel = getTileKernel();
+	uint64_t tile[32];
+	int last = first + count - 1;
+	int firstWord = first >> 5;
+	uint64_t word = makeWord(firstWord);
+	for (int w = firstWord; w <= (last >> 5); w++) {
+		uint64_t next = makeWord(w + 1);
+		int tileStart = w << 5;
+		if (tileStart >= first && tileStart + 31 <= last) {
+			kernel(word, next, k, hashList + (tileStart - first));
+		} else {
+			kernel(word, next, k, tile);
+			int from = std::max(first, tileStart);
+			int to = std::min(last, tileStart + 31);
+			std::copy(tile + (from - tileStart), tile + (to - tileStart) + 1,
+					hashList + (from - first));
+		}
+		word = next;
+	}
+}
+
+}
@@ -0,0 +1,152 @@
+/*
+ * PackedSequence.h
+ *
+ *  Created on: Oct 17, 2026
+ *
+ * A nucleotide sequence packed at 2 bits per base (A=0, C=1, G=2, T=3, the
+ * codes of ChromosomeOneDigit) with a separate mask of the unknown bases.
+ * It is built once per sequence; k-mer consumers read their hashes from it
+ * through KmerIterator or, a block at a time, through hashKmers instead of
+ * re-encoding the characters each time.
+ */
+
+#ifndef PACKEDSEQUENCE_H_
+#define PACKEDSEQUENCE_H_
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include <assert.h>
+
+namespace utility {
+
+class PackedSequence {
+public:
+	// LETTERS: A, C, G, and T; DIGITS: the codes 0-3 of ChromosomeOneDigit.
+	// Anything else is unknown.
+	enum class Alphabet { LETTERS, DIGITS };
+
+	// Codes are mapped through digitMap before they enter a hash
+	static const uint8_t IDENTITY_MAP[4];
+
+	// The k-mer hashes of up to this many positions are computed at once
+	static const int HASH_BLOCK = 1024;
+
+	// Implementations of hashKmers; the fastest one the CPU supports is picked at startup
+	enum class HashKernel { SCALAR, AVX2, AVX512 };
+
+	class KmerIterator;
+
+private:
+	/* Fields */
+	int length;
+	// 32 bases per word; base i is at bits 2 * (i % 32). Unknown bases are 0.
+	std::vector<uint64_t> codeList;
+	// 64 bases per word; a set bit is an unknown base
+	std::vector<uint64_t> unknownList;
+
+	/* Methods */
+	void pack(const char *, Alphabet);
+
+public:
+	/* Methods */
+	PackedSequence(const std::string &, Alphabet alphabet = Alphabet::LETTERS);
+	PackedSequence(const char *, int, Alphabet alphabet = Alphabet::LETTERS);
+
+	int size() const;
+
+	inline int codeAt(int i) const {
+		assert(i >= 0 && i < length);
+		return (codeList[i >> 5] >> ((i & 31) << 1)) & 3;
+	}
+
+	inline bool isUnknown(int i) const {
+		assert(i >= 0 && i < length);
+		return (unknownList[i >> 6] >> (i & 63)) & 1;
+	}
+
+	// Runs of known bases in [start, end); coordinates are inclusive as in
+	// KmerHistogram::makeSegments
+	std::vector<std::pair<int, int> > makeSegments(int start, int end) const;
+
+	// The letters; unknown bases are 'N'
+	std::string toString(int start, int end) const;
+
+	/**
+	 * The hashes of the count k-mers starting at first, into hashList; the
+	 * same hashes KmerIterator rolls. The k-mers must lie within the sequence.
+	 */
+	void hashKmers(int k, int first, int count, uint64_t *hashList,
+			const uint8_t *digitMap = IDENTITY_MAP) const;
+
+	/**
+	 * Calls f(position, hash) for the k-mers starting at first through last,
+	 * hashing HASH_BLOCK of them at a time into a buffer on the stack.
+	 */
+	template<class F>
+	void forEachKmer(int k, int first, int last, F f,
+			const uint8_t *digitMap = IDENTITY_MAP) const {
+		uint64_t hashList[HASH_BLOCK];
+		for (int blockStart = first; blockStart <= last; blockStart += HASH_BLOCK) {
+			int count = std::min(HASH_BLOCK, last - blockStart + 1);
+			hashKmers(k, blockStart, count, hashList, digitMap);
+			for (int i = 0; i < count; i++) {
+				f(blockStart + i, hashList[i]);
+			}
+		}
+	}
+
+	static HashKernel getHashKernel();
+	// For tests and benchmarks; a kernel the CPU does not support is ignored
+	static void setHashKernel(HashKernel kernel);
+};
+
+/**
+ * Rolling hashes of the consecutive k-mers of a packed sequence. The first
+ * base is the most significant digit, the same hash KmerHistogram and
+ * KmerHashTable compute from characters. The k-mers must not cover unknown
+ * bases; iterate within the segments.
+ */
+class PackedSequence::KmerIterator {
+private:
+	const PackedSequence &seq;
+	const uint8_t *digitMap;
+	uint64_t mask;
+	uint64_t hash;
+	int k;
+	// Start of the current k-mer
+	int start;
+
+public:
+	KmerIterator(const PackedSequence &seqIn, int kIn, int startIn,
+			const uint8_t *digitMapIn = IDENTITY_MAP) :
+			seq(seqIn), digitMap(digitMapIn), hash(0), k(kIn), start(startIn) {
+		assert(k >= 1 && k <= 32);
+		assert(start >= 0 && start + k <= seq.size());
+		mask = k == 32 ? ~0ULL : (1ULL << (2 * k)) - 1;
+		for (int i = start; i < start + k; i++) {
+			hash = (hash << 2) | digitMap[seq.codeAt(i)];
+		}
+	}
+
+	inline uint64_t operator*() const {
+		return hash;
+	}
+
+	inline int getStart() const {
+		return start;
+	}
+
+	// Moves to the next k-mer, which must be within the sequence
+	inline KmerIterator &operator++() {
+		hash = ((hash << 2) | digitMap[seq.codeAt(start + k)]) & mask;
+		start++;
+		return *this;
+	}
+};
+
+}
+
+#endif /* PACKEDSEQUENCE_H_ */